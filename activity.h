@@ -143,31 +143,27 @@ public:
         queue_order = order;
     }
 
+    /** Return the Queue order */
+    inline uint64_t getQueueOrder() const {
+        return queue_order;
+    }
+
 #ifdef USE_MEMPOOL
     /** Allocates memory from a memory pool for a new Activity */
 	void* operator new(std::size_t size) throw()
     {
-        /* 1) Find memory pool
-         * 1.5) If not found, create new
+        /* 1) Find memory pool in this thread's size class table
+         * 1.5) If not found, search the global list or create new
          * 2) Alloc item from pool
          * 3) Append PoolID to item, increment pointer
          */
+        size_t sclass = (size + 7) >> 3;
         Core::MemPool *pool = NULL;
-        size_t nPools = memPools.size();
-        std::thread::id tid = std::this_thread::get_id();
-        for ( size_t i = 0 ; i < nPools ; i++ ) {
-            PoolInfo_t &p = memPools[i];
-            if ( p.tid == tid && p.size == size ) {
-                pool = p.pool;
-                break;
-            }
+        if ( LIKELY(sclass < POOL_CLASS_COUNT) ) {
+            pool = threadPools[sclass];
         }
         if ( NULL == pool ) {
-            /* Still can't find it, alloc a new one */
-            pool = new Core::MemPool(size+sizeof(PoolData_t));
-
-            std::lock_guard<std::mutex> lock(poolMutex);
-            memPools.emplace_back(tid, size, pool);
+            pool = findPool(size);
         }
 
         PoolData_t *ptr = (PoolData_t*)pool->malloc();
@@ -219,10 +215,9 @@ public:
     static void printUndeletedActivites(const std::string& header, Output &out, SimTime_t before = MAX_SIMTIME_T) {
         for ( auto && entry : Activity::memPools ) {
             const std::list<uint8_t*>& arenas = entry.pool->getArenas();
-            size_t arenaSize = entry.pool->getArenaSize();
             size_t elemSize = entry.pool->getElementSize();
-            size_t nelem = arenaSize / elemSize;
             for ( auto iter = arenas.begin(); iter != arenas.end(); ++iter ) {
+                size_t nelem = entry.pool->getCarvedElements(*iter);
                 for ( size_t j = 0; j < nelem; j++ ) {
                     PoolData_t* ptr = (PoolData_t*)((*iter) + (elemSize*j));
                     if ( *ptr != NULL ) {
@@ -250,6 +245,8 @@ protected:
 
 
 private:
+    friend class EventWireFormat;
+
     uint64_t  queue_order;
     SimTime_t delivery_time;
     int       priority;
@@ -266,6 +263,14 @@ private:
     };
     static std::mutex poolMutex;
 	static std::vector<PoolInfo_t> memPools;
+    /** Number of 8 byte size classes looked up through threadPools */
+    static const size_t POOL_CLASS_COUNT = 128;
+    /** This thread's pools, indexed by size class */
+    static thread_local Core::MemPool* threadPools[POOL_CLASS_COUNT];
+    /** This thread's pools for sizes past the table, by size */
+    static thread_local std::unordered_map<size_t, Core::MemPool*> largePools;
+    /** Find (or create) this thread's pool for an allocation size */
+    static Core::MemPool* findPool(std::size_t size);
 #endif
 
     friend class boost::serialization::access;
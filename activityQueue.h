@@ -34,6 +34,11 @@ public:
     virtual Activity* pop() = 0;
     /** Insert a new activity into the queue */
     virtual void insert(Activity* activity) = 0;
+    /** Insert count activities into the queue, same as inserting them
+     * one at a time in array order */
+    virtual void insertBatch(Activity** activities, size_t count) {
+        for ( size_t i = 0; i < count; i++ ) insert(activities[i]);
+    }
     /** Returns the next activity */
     virtual Activity* front() = 0;
 
@@ -43,6 +43,11 @@ Clock::~Clock()
 
 bool Clock::registerHandler( Clock::HandlerBase* handler )
 {
+    // A suspended handler that is registered by hand is no longer
+    // waiting for a wakeup
+    if ( handler->suspended ) {
+        handler->suspend_list->remove(handler);
+    }
     staticHandlerMap.push_back( handler );	
     if ( !scheduled ) {
         schedule();
@@ -54,6 +59,10 @@ bool Clock::registerHandler( Clock::HandlerBase* handler )
 bool Clock::unregisterHandler( Clock::HandlerBase* handler, bool& empty )
 {
 
+    if ( handler->suspended ) {
+        handler->suspend_list->remove(handler);
+    }
+
     StaticHandlerMap_t::iterator iter = staticHandlerMap.begin();
 
     for ( ; iter != staticHandlerMap.end(); iter++ ) {
@@ -68,6 +77,28 @@ bool Clock::unregisterHandler( Clock::HandlerBase* handler, bool& empty )
     return 0;
 }
 
+void Clock::removeHandlers( SuspendList* suspend_list, std::vector<Clock::HandlerBase*>& removed )
+{
+    StaticHandlerMap_t::iterator iter = staticHandlerMap.begin();
+    while ( iter != staticHandlerMap.end() ) {
+        if ( (*iter)->suspend_list == suspend_list ) {
+            removed.push_back(*iter);
+            iter = staticHandlerMap.erase(iter);
+        }
+        else {
+            ++iter;
+        }
+    }
+}
+
+bool Clock::hasUnownedHandlers() const
+{
+    for ( StaticHandlerMap_t::const_iterator iter = staticHandlerMap.begin(); iter != staticHandlerMap.end(); ++iter ) {
+        if ( (*iter)->suspend_list == NULL ) return true;
+    }
+    return false;
+}
+
 Cycle_t
 Clock::getNextCycle()
 {
@@ -92,18 +123,40 @@ void Clock::execute( void ) {
     //bool group = false;	//Scoggin(Jan23,2015) fix unused varialble warning in build
     for ( sop_iter = staticHandlerMap.begin(); sop_iter != staticHandlerMap.end();  ) {
     	Clock::HandlerBase* handler = *sop_iter;
-    	if ( (*handler)(currentCycle) ) sop_iter = staticHandlerMap.erase(sop_iter);
-    	else ++sop_iter;
+    	switch ( handler->tick(currentCycle) ) {
+    	case CONTINUE:
+    	    ++sop_iter;
+    	    break;
+    	case SUSPEND:
+    	    suspendHandler(handler);
+    	    sop_iter = staticHandlerMap.erase(sop_iter);
+    	    break;
+    	default:
+    	    sop_iter = staticHandlerMap.erase(sop_iter);
+    	    break;
+    	}
     	// (*handler)(currentCycle);
     	// ++sop_iter;
     }
     
     next = sim->getCurrentSimCycle() + period->getFactor();
-    sim->insertActivity( next, this );
+    sim->insertClock( next, this );
 
     return;
 }
 
+void
+Clock::suspendHandler( Clock::HandlerBase* handler )
+{
+    if ( handler->suspend_list == NULL ) {
+        Simulation::getSimulation()->getSimulationOutput().
+            fatal(CALL_INFO, 1, "Clock handler returned SUSPEND, but was not"
+                  " registered through a Component, so no link can wake it up.\n");
+    }
+    handler->suspended = true;
+    handler->suspend_list->handlers.push_back(std::make_pair(this, handler));
+}
+
 void
 Clock::schedule()
 {
@@ -123,10 +176,53 @@ Clock::schedule()
     }
 
     // std::cout << "Scheduling clock " << period->getFactor() << " at cycle " << next << " current cycle is " << sim->getCurrentSimCycle() << std::endl;
-    sim->insertActivity(next, this);
+    sim->insertClock(next, this);
     scheduled = true;
 }
 
+Clock::SuspendList::~SuspendList()
+{
+    // Suspended handlers are not on any clock, so nobody else will
+    // delete them
+    for ( size_t i = 0; i < handlers.size(); i++ ) {
+        delete handlers[i].second;
+    }
+    handlers.clear();
+}
+
+void
+Clock::SuspendList::wakeup()
+{
+    // Swap the list out and clear the flags first so registerHandler()
+    // does not try to remove the handlers from the list being walked
+    std::vector<std::pair<Clock*, HandlerBase*> > waking;
+    waking.swap(handlers);
+    for ( size_t i = 0; i < waking.size(); i++ ) {
+        waking[i].second->suspended = false;
+        waking[i].first->registerHandler(waking[i].second);
+    }
+}
+
+void
+Clock::SuspendList::moveClocks(const std::function<Clock*(TimeConverter*)>& get_clock)
+{
+    for ( size_t i = 0; i < handlers.size(); i++ ) {
+        handlers[i].first = get_clock(handlers[i].first->period);
+    }
+}
+
+void
+Clock::SuspendList::remove(HandlerBase* handler)
+{
+    for ( size_t i = 0; i < handlers.size(); i++ ) {
+        if ( handlers[i].second == handler ) {
+            handlers.erase(handlers.begin() + i);
+            break;
+        }
+    }
+    handler->suspended = false;
+}
+
 void
 Clock::print(const std::string& header, Output &out) const
 {
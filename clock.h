@@ -17,6 +17,7 @@
 
 //#include <deque>
 //#include <list>
+#include <functional>
 #include <vector>
 
 #include <sst/core/action.h>
@@ -41,12 +42,67 @@ public:
     Clock( TimeConverter* period, int priority = CLOCKPRIORITY);
     ~Clock();
 
+    /** What the Clock should do with a handler after calling it.
+     * Handlers returning bool map false to CONTINUE and true to
+     * UNREGISTER. */
+    typedef enum {
+        CONTINUE = 0,    /*!< Keep calling the handler every cycle */
+        UNREGISTER = 1,  /*!< Remove the handler from the clock */
+        SUSPEND = 2      /*!< Stop calling the handler until an Event is
+                           delivered on one of the owning Component's links */
+    } HandlerReturn_t;
+
+    class SuspendList;
+
     /** Functor classes for Clock handling */
     class HandlerBase {
     public:
+        HandlerBase() : suspend_list(NULL), suspended(false) {}
+
         /** Function called when Handler is invoked */
         virtual bool operator()(Cycle_t) = 0;
+        /** Function called by the Clock on each tick.  Returns how the
+         * Clock should treat the handler afterwards */
+        virtual HandlerReturn_t tick(Cycle_t cycle) {
+            return (*this)(cycle) ? UNREGISTER : CONTINUE;
+        }
         virtual ~HandlerBase() {}
+
+    private:
+        friend class Clock;
+        friend class Component;
+
+        /** Where the handler goes when it suspends itself.  Set for
+         * handlers registered through a Component */
+        SuspendList* suspend_list;
+        bool suspended;
+    };
+
+    /** Handlers belonging to one Component which have suspended
+     * themselves.  The Component's links wake them up when they
+     * deliver an Event. */
+    class SuspendList {
+    public:
+        SuspendList() {}
+        ~SuspendList();
+
+        bool empty() const { return handlers.empty(); }
+
+        /** Put every suspended handler back on its clock.  The
+         * handlers are next called on their clock's next cycle. */
+        void wakeup();
+
+        /** Move the handlers to the clock get_clock returns for the
+         * period of the clock they were suspended from.  Used when the
+         * owning Component moves to another thread. */
+        void moveClocks(const std::function<Clock*(TimeConverter*)>& get_clock);
+
+    private:
+        friend class Clock;
+
+        void remove(HandlerBase* handler);
+
+        std::vector<std::pair<Clock*, HandlerBase*> > handlers;
     };
 
 
@@ -104,9 +160,73 @@ public:
         }
     };
 
+    /** Clock Handler class whose member function may suspend itself,
+     * with user-data argument
+     * @tparam classT Type of the Object
+     * @tparam argT Type of the argument
+     */
+    template <typename classT, typename argT = void>
+    class SuspendHandler : public HandlerBase {
+    private:
+        typedef HandlerReturn_t (classT::*PtrMember)(Cycle_t, argT);
+        classT* object;
+        const PtrMember member;
+        argT data;
+
+    public:
+        /** Constructor
+         * @param object - Pointer to Object upon which to call the handler
+         * @param member - Member function to call as the handler
+         * @param data - Additional argument to pass to handler
+         */
+        SuspendHandler( classT* const object, PtrMember member, argT data ) :
+            object(object),
+            member(member),
+            data(data)
+        {}
+
+        bool operator()(Cycle_t cycle) {
+            return tick(cycle) == UNREGISTER;
+        }
+
+        HandlerReturn_t tick(Cycle_t cycle) {
+            return (object->*member)(cycle,data);
+        }
+    };
+
+    /** Clock Handler class whose member function may suspend itself,
+     * without user-data
+     * @tparam classT Type of the Object
+     */
+    template <typename classT>
+    class SuspendHandler<classT, void> : public HandlerBase {
+    private:
+        typedef HandlerReturn_t (classT::*PtrMember)(Cycle_t);
+        classT* object;
+        const PtrMember member;
+
+    public:
+        /** Constructor
+         * @param object - Pointer to Object upon which to call the handler
+         * @param member - Member function to call as the handler
+         */
+        SuspendHandler( classT* const object, PtrMember member ) :
+            object(object),
+            member(member)
+        {}
+
+        bool operator()(Cycle_t cycle) {
+            return tick(cycle) == UNREGISTER;
+        }
+
+        HandlerReturn_t tick(Cycle_t cycle) {
+            return (object->*member)(cycle);
+        }
+    };
+
     /**
      * Activates this clock object, by inserting into the simulation's
-     * timeVortex for future execution.
+     * clockRing for future execution.
      */
     void schedule();
 
@@ -118,6 +238,17 @@ public:
     /** Remove a handler from the list of handlers to be called on the clock tick */
     bool unregisterHandler( Clock::HandlerBase* handler, bool& empty );
 
+    /** Remove the handlers registered through the Component owning
+     * suspend_list and append them to removed.  Used when the
+     * Component moves to another thread. */
+    void removeHandlers( SuspendList* suspend_list, std::vector<Clock::HandlerBase*>& removed );
+    /** Return true if any handler was registered directly with the
+     * Simulation rather than through a Component */
+    bool hasUnownedHandlers() const;
+
+    /** Return the period of the clock */
+    TimeConverter* getPeriod() const { return period; }
+
     void print(const std::string& header, Output &out) const;
     
 private:
@@ -128,6 +259,7 @@ private:
     Clock() { }
 
     void execute( void );
+    void suspendHandler( Clock::HandlerBase* handler );
 
     Cycle_t            currentCycle;
     TimeConverter*     period;
@@ -0,0 +1,67 @@
+// Copyright 2009-2015 Sandia Corporation. Under the terms
+// of Contract DE-AC04-94AL85000 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+// 
+// Copyright (c) 2009-2015, Sandia Corporation
+// All rights reserved.
+// 
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include "sst_config.h"
+#include "sst/core/serialization.h"
+
+#include <sst/core/clockRing.h>
+#include <sst/core/output.h>
+#include <sst/core/timeVortex.h>
+
+namespace SST {
+
+ClockRing::ClockRing(TimeVortex* tv) :
+    ActivityQueue(),
+    tv(tv)
+{}
+
+ClockRing::~ClockRing()
+{
+    // Clocks in the ring all need to be deleted
+    for ( std::deque<Activity*>::iterator it = data.begin(); it != data.end(); ++it ) {
+        delete *it;
+    }
+    data.clear();
+}
+
+void ClockRing::insert(Activity* activity)
+{
+    activity->setQueueOrder(tv->reserveQueueOrder());
+    tv->addHeld();
+
+    // Search backwards for the first entry that sorts before the new
+    // one.  The new entry is the latest so far in the common case.
+    std::deque<Activity*>::iterator it = data.end();
+    while ( it != data.begin() && later(*(it - 1), activity) ) --it;
+    data.insert(it, activity);
+}
+
+Activity* ClockRing::pop()
+{
+    if ( data.empty() ) return NULL;
+    Activity* ret_val = data.front();
+    data.pop_front();
+    tv->removeHeld();
+    return ret_val;
+}
+
+void ClockRing::print(Output &out) const
+{
+    out.output("ClockRing state:\n");
+    for ( std::deque<Activity*>::const_iterator it = data.begin(); it != data.end(); ++it ) {
+        (*it)->print("  ", out);
+    }
+}
+
+} // namespace SST
+
+BOOST_CLASS_EXPORT_IMPLEMENT(SST::ClockRing)
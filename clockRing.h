@@ -0,0 +1,76 @@
+// Copyright 2009-2015 Sandia Corporation. Under the terms
+// of Contract DE-AC04-94AL85000 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+// 
+// Copyright (c) 2009-2015, Sandia Corporation
+// All rights reserved.
+// 
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef SST_CORE_CLOCKRING_H
+#define SST_CORE_CLOCKRING_H
+
+#include <sst/core/serialization.h>
+
+#include <cstdio> // For printf
+#include <deque>
+
+#include <sst/core/activityQueue.h>
+
+namespace SST {
+
+class Output;
+class TimeVortex;
+
+/**
+ * Queue holding the scheduled Clock objects, kept separate from the
+ * TimeVortex.  Simulation::run() merges the front of this queue with
+ * the front of the TimeVortex.
+ *
+ * Clocks are kept in a ring sorted by (time, priority, queue order).
+ * A clock that has just fired is re-inserted one period later, which
+ * is almost always at or near the end of the ring, so the insertion
+ * point is found by searching backwards from the end.  Queue orders
+ * come from the TimeVortex, so clocks sort against other Activities
+ * exactly as if they were in the TimeVortex.
+ */
+class ClockRing : public ActivityQueue {
+public:
+    ClockRing(TimeVortex* tv);
+    ~ClockRing();
+
+    bool empty() { return data.empty(); }
+    int size() { return data.size(); }
+    void insert(Activity* activity);
+    Activity* pop();
+    Activity* front() { return data.empty() ? NULL : data.front(); }
+
+    /** Print the state of the ClockRing */
+    void print(Output &out) const;
+
+private:
+    ClockRing() {} // For serialization only
+
+    TimeVortex* tv;
+    std::deque<Activity*> data;
+
+    Activity::pq_less_time_priority later;
+
+    friend class boost::serialization::access;
+    template<class Archive>
+    void
+    serialize(Archive & ar, const unsigned int version )
+    {
+        printf("begin ClockRing::serialize\n");
+        ar & BOOST_SERIALIZATION_BASE_OBJECT_NVP(ActivityQueue);
+        printf("end ClockRing::serialize\n");
+    }
+};
+
+} //namespace SST
+
+BOOST_CLASS_EXPORT_KEY(SST::ClockRing)
+
+#endif // SST_CORE_CLOCKRING_H
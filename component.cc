@@ -102,6 +102,7 @@ Component::isPortValidForComponent(const std::string& comp_name, const std::stri
 
 
 TimeConverter* Component::registerClock( std::string freq, Clock::HandlerBase* handler, bool regAll) {
+    handler->suspend_list = &suspendedClocks;
     TimeConverter* tc = getSimulation()->registerClock(freq,handler);
     
     // if regAll is true set tc as the default for the component and
@@ -122,6 +123,7 @@ TimeConverter* Component::registerClock( std::string freq, Clock::HandlerBase* h
 }
 
 TimeConverter* Component::registerClock( const UnitAlgebra& freq, Clock::HandlerBase* handler, bool regAll) {
+    handler->suspend_list = &suspendedClocks;
     TimeConverter* tc = getSimulation()->registerClock(freq,handler);
     
     // if regAll is true set tc as the default for the component and
@@ -154,10 +156,12 @@ void Component::unregisterClock(TimeConverter *tc, Clock::HandlerBase* handler)
 }
 
 TimeConverter* Component::registerOneShot( std::string timeDelay, OneShot::HandlerBase* handler) {
+    handler->owner = this;
     return getSimulation()->registerOneShot(timeDelay, handler);
 }
 
 TimeConverter* Component::registerOneShot( const UnitAlgebra& timeDelay, OneShot::HandlerBase* handler) {
+    handler->owner = this;
     return getSimulation()->registerOneShot(timeDelay, handler);
 }
 
@@ -218,6 +222,7 @@ Component::configureLink(std::string name, TimeConverter* time_base, Event::Hand
         tmp->setPolling();
     }
     tmp->setFunctor(handler);
+    tmp->suspend_list = &suspendedClocks;
     tmp->setDefaultTimeBase(time_base);
 #ifdef __SST_DEBUG_EVENT_TRACKING__
     tmp->setSendingComponentInfo(my_info->getName(), my_info->getType(), name);
@@ -249,6 +254,7 @@ Component::configureLink(std::string name, Event::HandlerBase* handler)
         tmp->setPolling();
     }
     tmp->setFunctor(handler);
+    tmp->suspend_list = &suspendedClocks;
 #ifdef __SST_DEBUG_EVENT_TRACKING__
     tmp->setSendingComponentInfo(my_info->getName(), my_info->getType(), name);
 #endif
@@ -304,6 +310,7 @@ Link* Component::selfLink( std::string name, Event::HandlerBase* handler )
     if ( handler == NULL ) {
 	link->setPolling();
     }
+    link->suspend_list = &suspendedClocks;
     return link;
 }
     
@@ -158,6 +158,12 @@ public:
         at the specified interval
         @param regAll Should this clock perioud be used as the default
         time base for all of the links connected to this component
+
+        A handler built as a Clock::SuspendHandler may return
+        Clock::SUSPEND to stop being called.  It is put back on its
+        clock, starting with the clock's next cycle, as soon as an
+        Event is delivered to a handler on any of this component's
+        links.  Polling links do not wake suspended handlers.
     */
     TimeConverter* registerClock( std::string freq, Clock::HandlerBase* handler,
                                   bool regAll = true);
@@ -375,6 +381,7 @@ protected:
 
 private:
 
+    friend class Simulation;
     friend class SubComponent;
 
     void addSelfLink(std::string name);
@@ -394,6 +401,8 @@ private:
 
     // LinkMap* myLinks;
     std::string currentlyLoadingSubComponent;
+    /** Clock handlers waiting for an Event on one of our links */
+    Clock::SuspendList suspendedClocks;
 
 
 
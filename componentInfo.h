@@ -129,6 +129,11 @@ public:
         dataByID.insert(info);
     }
 
+    void erase(ComponentInfo* info) {
+        dataByName.erase(info);
+        dataByID.erase(info);
+    }
+
     ComponentInfo* getByName(const std::string& key) const {
         ComponentInfo infoKey(0, key, "", NULL);
         auto value = dataByName.find(&infoKey);
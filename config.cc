@@ -14,6 +14,7 @@
 #include "sst/core/serialization.h"
 #include "sst/core/config.h"
 #include "sst/core/part/sstpart.h"
+#include "sst/core/timeVortex.h"
 
 #include <errno.h>
 #include <iostream>
@@ -53,6 +54,13 @@ Config::Config(RankInfo rankInfo)
     timeBase    = "1 ps";
     heartbeatPeriod = "N";
     partitioner = "linear";
+    timeVortex  = "pq";
+    thread_sync = "simple";
+    rank_sync = "serial";
+    thread_barrier = "central";
+    thread_affinity = "none";
+    thread_balance_threshold = 0.0;
+    thread_balance_period = "1 us";
     generator   = "NONE";
     generator_options   = "";
     dump_component_graph_file = "";
@@ -65,11 +73,17 @@ Config::Config(RankInfo rankInfo)
     world_size.thread = 1;
     no_env_config = false;
     enable_sig_handling = true;
+    link_stats = false;
     output_core_prefix = "@x SST Core: ";
 
 #ifdef __SST_DEBUG_EVENT_TRACKING__
     event_dump_file = "";
 #endif
+#ifdef USE_MEMPOOL
+    mempool_hugepages = "none";
+    mempool_lazy = false;
+    mempool_numa = false;
+#endif
     
     // Some config items can be initialized from either the command line or
     // the config file. The command line has precedence. We need to initialize
@@ -116,6 +130,20 @@ Config::Config(RankInfo rankInfo)
         part_desc.append("\n-  ").append(it->first).append(": ").append(it->second);
     }
     part_desc.append("\n-  lib.partitioner_name: Partitioner found in element library 'lib' with name 'partitioner_name'");
+
+    // Build the string for the timeVortex help
+    string tv_desc;
+    tv_desc.append("primary event queue implementation to be used < ");
+    desc = SST::TimeVortex::getDescriptionMap();
+    prefix = "";
+    for ( map<string,string>::const_iterator it = desc.begin(); it != desc.end() ; ++it ) {
+        tv_desc.append(prefix).append(it->first);
+        prefix = " | ";
+    }
+    tv_desc.append(" >\nDescriptions:");
+    for ( map<string,string>::const_iterator it = desc.begin(); it != desc.end() ; ++it ) {
+        tv_desc.append("\n-  ").append(it->first).append(": ").append(it->second);
+    }
     mainDesc = new po::options_description( "" );
     mainDesc->add_options()
         ("debug-file", po::value <string> ( &debugFile ),
@@ -136,6 +164,21 @@ Config::Config(RankInfo rankInfo)
         ("partitioner", po::value< string >(&partitioner),
          part_desc.c_str())
 #endif
+        ("time-vortex", po::value< string >(&timeVortex),
+         tv_desc.c_str())
+        ("thread-sync", po::value< string >(&thread_sync),
+         "synchronization between threads of a rank [ simple | direct | cmb ] (default: simple)")
+        ("rank-sync", po::value< string >(&rank_sync),
+         "synchronization between ranks [ serial | parallel ] (default: serial)")
+        ("thread-barrier", po::value< string >(&thread_barrier),
+         "barrier between threads of a rank [ central | dissemination ] (default: central)")
+        ("thread-affinity", po::value< string >(&thread_affinity),
+         "bind the threads of each rank to CPUs [ none | compact | scatter | <cpu list, e.g. 0,2,4-7> ] (default: none); ranks on one node with the same CPU mask take separate shares of it with compact and scatter")
+        ("thread-balance-threshold", po::value< double >(&thread_balance_threshold),
+         "when the busiest thread of a rank is busy more than this many times the average, report it and move components off that thread (simple and direct thread syncs only; events tied on time and priority may then run in a different order from run to run) (default: 0, no checks)")
+        ("thread-balance-period", po::value< string >(&thread_balance_period),
+         "simulated time between thread load balance checks (default: 1 us)")
+        ("link-stats", "Count the events, bytes and first/last send time on every link and output them as statistics at the end of simulation")
 
         ("generator", po::value< string >(&generator),
          "generator to be used to build simulation <lib.generator_name>")
@@ -162,6 +205,10 @@ Config::Config(RankInfo rankInfo)
 #ifdef USE_MEMPOOL
         ("output-undeleted-events", po::value<string>(&event_dump_file),
          "Outputs information about all undeleted events to the specified file at end of simulation (STDOUT and STDERR can be used to output to console on stdout and stderr")
+        ("mempool-hugepages", po::value<string>(&mempool_hugepages),
+         "Page size for event memory pool arenas [ none | thp | explicit ] (default: none)")
+        ("mempool-lazy", "Hand out event memory pool slots as they are needed instead of touching whole arenas when they are created")
+        ("mempool-numa", "Place event memory pool arenas on the NUMA node of the thread that allocates from them")
 #endif
         ("output-xml", po::value< string >(&output_xml),
          "Dump the SST component and link configuration graph to this file (as an XML file), empty string (default) is not to dump anything.")
@@ -228,6 +275,11 @@ Config::parseCmdLine(int argc, char* argv[]) {
 
     verbose = var_map->count( "verbose" );
     enable_sig_handling = (var_map->count("disable-signal-handlers") > 0) ? false : true;
+    link_stats = (var_map->count("link-stats") > 0);
+#ifdef USE_MEMPOOL
+    mempool_lazy = (var_map->count("mempool-lazy") > 0);
+    mempool_numa = (var_map->count("mempool-numa") > 0);
+#endif
 
     if ( var_map->count( "version" ) ) {
         cout << "SST Release Version (" PACKAGE_VERSION << ", " SST_SVN_REVISION ")" << endl;
@@ -64,6 +64,13 @@ public:
     std::string     heartbeatPeriod;    /*!< Sets the heartbeat period for the simulation */
     std::string     timeBase;           /*!< Timebase of simulation */
     std::string     partitioner;        /*!< Partitioner to use */
+    std::string     timeVortex;         /*!< TimeVortex implementation to use */
+    std::string     thread_sync;        /*!< Synchronization to use between threads of a rank */
+    std::string     rank_sync;          /*!< Synchronization to use between ranks */
+    std::string     thread_barrier;     /*!< Barrier algorithm to use between threads of a rank */
+    std::string     thread_affinity;    /*!< CPU placement of the threads of a rank (none, compact, scatter, cpu list) */
+    double          thread_balance_threshold; /*!< Busiest thread to average busy time ratio that is reported and rebalanced (0 is off).  Moving Components reorders tied events, so such runs are not repeatable */
+    std::string     thread_balance_period; /*!< Simulated time between thread load balance checks */
     std::string     generator;          /*!< Generator to use */
     std::string     generator_options;  /*!< Options to pass to the generator */
     std::string     output_config_graph;  /*!< File to dump configuration graph */
@@ -79,9 +86,13 @@ public:
     uint32_t        verbose;            /*!< Verbosity */
     bool	    no_env_config;      /*!< Bypass compile-time environmental configuration */
     bool            enable_sig_handling; /*!< Enable signal handling */
+    bool            link_stats;         /*!< Count the traffic on every link */
 
 #ifdef USE_MEMPOOL
     std::string     event_dump_file;    /*!< File to dump undeleted events to */
+    std::string     mempool_hugepages;  /*!< Page size for event pool arenas (none, thp, explicit) */
+    bool            mempool_lazy;       /*!< Carve event pool slots on demand */
+    bool            mempool_numa;       /*!< Place event pool arenas on the owner's NUMA node */
 #endif
     /** Set the run-mode
      * @param mode - string "init" "run" "both"
@@ -108,6 +119,13 @@ public:
 		std::cout << "stopAtCycle = " << stopAtCycle << std::endl;
 		std::cout << "timeBase = " << timeBase << std::endl;
 		std::cout << "partitioner = " << partitioner << std::endl;
+		std::cout << "timeVortex = " << timeVortex << std::endl;
+		std::cout << "thread_sync = " << thread_sync << std::endl;
+		std::cout << "rank_sync = " << rank_sync << std::endl;
+		std::cout << "thread_barrier = " << thread_barrier << std::endl;
+		std::cout << "thread_affinity = " << thread_affinity << std::endl;
+		std::cout << "thread_balance_threshold = " << thread_balance_threshold << std::endl;
+		std::cout << "thread_balance_period = " << thread_balance_period << std::endl;
 		std::cout << "generator = " << generator << std::endl;
 		std::cout << "gen_options = " << generator_options << std::endl;
 		std::cout << "output_config_graph = " << output_config_graph << std::endl;
@@ -118,6 +136,7 @@ public:
 		std::cout << "model_options = " << model_options << std::endl;
         std::cout << "num_threads = " << world_size.thread << std::endl;
 		std::cout << "enable_sig_handling = " << enable_sig_handling << std::endl;
+		std::cout << "link_stats = " << link_stats << std::endl;
 		std::cout << "output_core_prefix = " << output_core_prefix << std::endl;
 	}
 
@@ -160,6 +179,13 @@ private:
         ar & BOOST_SERIALIZATION_NVP(stopAtCycle);
         ar & BOOST_SERIALIZATION_NVP(timeBase);
         ar & BOOST_SERIALIZATION_NVP(partitioner);
+        ar & BOOST_SERIALIZATION_NVP(timeVortex);
+        ar & BOOST_SERIALIZATION_NVP(thread_sync);
+        ar & BOOST_SERIALIZATION_NVP(rank_sync);
+        ar & BOOST_SERIALIZATION_NVP(thread_barrier);
+        ar & BOOST_SERIALIZATION_NVP(thread_affinity);
+        ar & BOOST_SERIALIZATION_NVP(thread_balance_threshold);
+        ar & BOOST_SERIALIZATION_NVP(thread_balance_period);
         ar & BOOST_SERIALIZATION_NVP(generator);
         ar & BOOST_SERIALIZATION_NVP(generator_options);
         ar & BOOST_SERIALIZATION_NVP(dump_component_graph_file);
@@ -170,6 +196,7 @@ private:
         ar & BOOST_SERIALIZATION_NVP(model_options);
         ar & BOOST_SERIALIZATION_NVP(world_size);
 	    ar & BOOST_SERIALIZATION_NVP(enable_sig_handling);
+        ar & BOOST_SERIALIZATION_NVP(link_stats);
         ar & BOOST_SERIALIZATION_NVP(output_core_prefix);
     }
     
@@ -13,6 +13,7 @@
 #include "sst_config.h"
 #include "sst/core/serialization.h"
 #include "sst/core/event.h"
+#include "sst/core/eventWireFormat.h"
 #include "sst/core/simulation.h"
 
 #include "sst/core/link.h"
@@ -28,6 +29,7 @@ Event::~Event() {}
 
 void Event::execute(void)
 {
+    delivery_link->advanceDelayLine(this);
     delivery_link->deliverEvent(this);
 }
 
@@ -62,6 +64,7 @@ void Event::serialize(Archive & ar, const unsigned int version)
 
 void NullEvent::execute(void)
 {
+    delivery_link->advanceDelayLine(this);
     delivery_link->deliverEvent(NULL);
     delete this;
 }
@@ -77,6 +80,41 @@ void NullEvent::serialize(Archive & ar, const unsigned int version)
 #ifdef USE_MEMPOOL
 std::mutex Activity::poolMutex;
 std::vector<Activity::PoolInfo_t> Activity::memPools;
+thread_local Core::MemPool* Activity::threadPools[Activity::POOL_CLASS_COUNT];
+thread_local std::unordered_map<size_t, Core::MemPool*> Activity::largePools;
+
+Core::MemPool*
+Activity::findPool(std::size_t size)
+{
+    // Sizes covered by the table share one pool per size class
+    size_t sclass = (size + 7) >> 3;
+    if ( sclass < POOL_CLASS_COUNT ) size = sclass << 3;
+    else {
+        // Larger sizes are cached per thread so the lock is only taken
+        // the first time this thread sees a size
+        std::unordered_map<size_t, Core::MemPool*>::iterator it = largePools.find(size);
+        if ( it != largePools.end() ) return it->second;
+    }
+
+    std::thread::id tid = std::this_thread::get_id();
+    std::lock_guard<std::mutex> lock(poolMutex);
+    Core::MemPool *pool = NULL;
+    for ( size_t i = 0 ; i < memPools.size() ; i++ ) {
+        PoolInfo_t &p = memPools[i];
+        if ( p.tid == tid && p.size == size ) {
+            pool = p.pool;
+            break;
+        }
+    }
+    if ( NULL == pool ) {
+        /* Still can't find it, alloc a new one */
+        pool = new Core::MemPool(size+sizeof(PoolData_t));
+        memPools.emplace_back(tid, size, pool);
+    }
+    if ( sclass < POOL_CLASS_COUNT ) threadPools[sclass] = pool;
+    else largePools[size] = pool;
+    return pool;
+}
 #endif
 
 } // namespace SST
@@ -87,3 +125,5 @@ SST_BOOST_SERIALIZATION_INSTANTIATE(SST::NullEvent::serialize)
 
 BOOST_CLASS_EXPORT_IMPLEMENT(SST::Event)
 BOOST_CLASS_EXPORT_IMPLEMENT(SST::NullEvent)
+
+SST_WIRE_FORMAT_TRIVIAL_EVENT(SST::NullEvent, 1)
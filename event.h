@@ -51,6 +51,10 @@ public:
 
     /** Clones the event in for the case of a broadcast */
     virtual Event* clone();
+
+    /** Size of the event in bytes, as counted by link traffic
+     * statistics.  Events that do not override this count as 0 bytes */
+    virtual uint64_t getTrafficBytes() const { return 0; }
     
     /** Sets the link id used for delivery.  For use by SST Core only */
     inline void setDeliveryLink(LinkId_t id, Link *link) {
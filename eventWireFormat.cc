@@ -0,0 +1,161 @@
+// Copyright 2009-2015 Sandia Corporation. Under the terms
+// of Contract DE-AC04-94AL85000 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2015, Sandia Corporation
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include "sst_config.h"
+#include "sst/core/serialization.h"
+#include "sst/core/eventWireFormat.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <typeindex>
+#include <unordered_map>
+
+#include "sst/core/event.h"
+#include "sst/core/simulation.h"
+
+namespace SST {
+
+namespace {
+
+struct Entry {
+    EventWireFormat::type_id_t id;
+    EventWireFormat::encode_t encode;
+    EventWireFormat::decode_t decode;
+};
+
+// Types are registered while libraries are loaded, before any events
+// are exchanged, so lookups do not need the lock
+std::mutex& registryMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::unordered_map<std::type_index, Entry>& typeMap()
+{
+    static std::unordered_map<std::type_index, Entry> map;
+    return map;
+}
+
+std::unordered_map<EventWireFormat::type_id_t, Entry>& idMap()
+{
+    static std::unordered_map<EventWireFormat::type_id_t, Entry> map;
+    return map;
+}
+
+// A derived Event's first member could otherwise be placed in the tail
+// padding of Event, where the trivial copy would miss it
+struct TailPaddingProbe : public Event {
+    char c;
+};
+static_assert(sizeof(TailPaddingProbe) > sizeof(Event), "Event has tail padding, so trivial Event types cannot skip it");
+
+struct RecordHeader {
+    EventWireFormat::type_id_t id;
+    uint32_t size;
+    SimTime_t delivery_time;
+    LinkId_t link_id;
+    int32_t priority;
+    // Explicit so no uninitialized padding is copied into the buffer
+    uint32_t pad;
+};
+static_assert(sizeof(RecordHeader) == 2 * sizeof(uint32_t) + sizeof(SimTime_t) + sizeof(LinkId_t) + 2 * sizeof(int32_t), "RecordHeader has implicit padding");
+
+} // anonymous namespace
+
+const EventWireFormat::type_id_t EventWireFormat::BOOST_TYPE;
+
+void
+EventWireFormat::registerType(type_id_t id, const std::type_info& type, encode_t encode, decode_t decode)
+{
+    std::lock_guard<std::mutex> lock(registryMutex());
+
+    if ( id == BOOST_TYPE ) {
+        fprintf(stderr, "EventWireFormat: type id %u is reserved (registering %s)\n", id, type.name());
+        abort();
+    }
+
+    auto by_id = idMap().find(id);
+    if ( by_id != idMap().end() ) {
+        auto by_type = typeMap().find(std::type_index(type));
+        if ( by_type != typeMap().end() && by_type->second.id == id ) return;
+        fprintf(stderr, "EventWireFormat: type id %u registered for more than one Event type (%s)\n", id, type.name());
+        abort();
+    }
+    if ( typeMap().find(std::type_index(type)) != typeMap().end() ) {
+        fprintf(stderr, "EventWireFormat: %s registered with more than one type id\n", type.name());
+        abort();
+    }
+
+    Entry entry = { id, encode, decode };
+    idMap()[id] = entry;
+    typeMap()[std::type_index(type)] = entry;
+}
+
+bool
+EventWireFormat::encode(const Activity* act, std::vector<char>& buffer)
+{
+    auto entry = typeMap().find(std::type_index(typeid(*act)));
+    if ( entry == typeMap().end() ) return false;
+
+    const Event* ev = static_cast<const Event*>(act);
+
+    // The header goes in first and gets the payload size once the
+    // payload has been written
+    size_t start = buffer.size();
+    buffer.resize(start + sizeof(RecordHeader));
+    entry->second.encode(ev, buffer);
+
+    RecordHeader hdr;
+    hdr.id = entry->second.id;
+    hdr.size = buffer.size() - start - sizeof(RecordHeader);
+    hdr.delivery_time = ev->getDeliveryTime();
+    hdr.link_id = ev->getLinkId();
+    hdr.priority = ev->getPriority();
+    hdr.pad = 0;
+    std::memcpy(&buffer[start], &hdr, sizeof(RecordHeader));
+    return true;
+}
+
+void
+EventWireFormat::encodeFallback(std::vector<char>& buffer)
+{
+    append(buffer, BOOST_TYPE);
+}
+
+Activity*
+EventWireFormat::decode(const char*& data)
+{
+    type_id_t id;
+    std::memcpy(&id, data, sizeof(type_id_t));
+    if ( id == BOOST_TYPE ) {
+        data += sizeof(type_id_t);
+        return NULL;
+    }
+
+    RecordHeader hdr;
+    std::memcpy(&hdr, data, sizeof(RecordHeader));
+    auto entry = idMap().find(hdr.id);
+    if ( entry == idMap().end() ) {
+        Simulation::getSimulationOutput().fatal(CALL_INFO, 1, "EventWireFormat: received unknown Event type id %u\n", hdr.id);
+    }
+
+    Event* ev = entry->second.decode(data + sizeof(RecordHeader), hdr.size);
+    ev->setDeliveryTime(hdr.delivery_time);
+    ev->setPriority(hdr.priority);
+    ev->setDeliveryLink(hdr.link_id, NULL);
+
+    data += sizeof(RecordHeader) + hdr.size;
+    return ev;
+}
+
+} // namespace SST
@@ -0,0 +1,135 @@
+// Copyright 2009-2015 Sandia Corporation. Under the terms
+// of Contract DE-AC04-94AL85000 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2015, Sandia Corporation
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef SST_CORE_EVENTWIREFORMAT_H
+#define SST_CORE_EVENTWIREFORMAT_H
+
+#include <sst/core/sst_types.h>
+#include <sst/core/event.h>
+
+#include <cstring>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
+namespace SST {
+
+/**
+ * \class EventWireFormat
+ *
+ * Compact encoding of the Events sent between ranks.  Event types can
+ * register a fixed type id together with an encode and a decode
+ * routine, or be registered as trivially copyable so that the core
+ * copies their data members directly.  Events of any other type are
+ * still sent through boost serialization.
+ *
+ * Each registered Event becomes one record: a type id, the payload
+ * size, the delivery time, priority and link id, then the payload.
+ * Type ids are chosen by the Event's author and must be the same on
+ * every rank; 0 is reserved for the boost fallback and 1-15 for the
+ * core's own Events.
+ */
+class EventWireFormat {
+public:
+    typedef uint32_t type_id_t;
+
+    /** Append the type specific data of the Event to the buffer */
+    typedef void (*encode_t)(const Event* ev, std::vector<char>& buffer);
+    /** Create an Event from the data written by the matching encode_t */
+    typedef Event* (*decode_t)(const char* data, size_t size);
+
+    /** Type id of Events that go through boost serialization */
+    static const type_id_t BOOST_TYPE = 0;
+
+    /** Register an Event type with its own encode and decode routines.
+     * Registering the same type with the same id more than once is
+     * harmless; anything else is a fatal error. */
+    static void registerType(type_id_t id, const std::type_info& type, encode_t encode, decode_t decode);
+
+    /** Register an Event type whose own data members (the ones it adds
+     * to Event) can all be copied with memcpy (no pointers, strings or
+     * containers).  The Event base is already in the record header and
+     * is not copied.  The type must be default constructible and derive
+     * from Event through single, non-virtual inheritance only; multiple
+     * and virtual inheritance are not supported.  The receiving side
+     * default constructs it and copies the data members over it. */
+    template <class T>
+    static void registerTrivialType(type_id_t id) {
+        static_assert(std::is_base_of<Event, T>::value, "Only Events can be registered with the EventWireFormat");
+        static_assert(std::is_polymorphic<T>::value, "Trivial Event types must be polymorphic");
+        static_assert(sizeof(T) >= sizeof(Event), "Trivial Event types must contain the Event base");
+#ifndef __SST_DEBUG_EVENT_TRACKING__
+        // Event tracking adds strings to every Event, so such builds
+        // always use boost
+        registerType(id, typeid(T), &encodeTrivial<T>, &decodeTrivial<T>);
+#endif
+    }
+
+    /** Append an Activity to the buffer.  Returns false, without
+     * writing anything, if the Activity's type is not registered. */
+    static bool encode(const Activity* act, std::vector<char>& buffer);
+
+    /** Decode the record at data and move data to the next record.
+     * Returns NULL for a boost fallback record, whose Activity is the
+     * next one in the boost archive. */
+    static Activity* decode(const char*& data);
+
+    /** Write the record marking an Activity sent through boost */
+    static void encodeFallback(std::vector<char>& buffer);
+
+    /** Helpers for encode and decode routines */
+    template <typename T>
+    static void append(std::vector<char>& buffer, const T& value) {
+        const char* bytes = reinterpret_cast<const char*>(&value);
+        buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+    }
+
+    template <typename T>
+    static T extract(const char*& data) {
+        T value;
+        std::memcpy(&value, data, sizeof(T));
+        data += sizeof(T);
+        return value;
+    }
+
+private:
+    /** Data members a trivial type adds start after the Event base,
+     * which single inheritance puts at the start of the object */
+    static const size_t DATA_OFFSET = sizeof(Event);
+
+    template <class T>
+    static void encodeTrivial(const Event* ev, std::vector<char>& buffer) {
+        const char* bytes = reinterpret_cast<const char*>(static_cast<const T*>(ev));
+        buffer.insert(buffer.end(), bytes + DATA_OFFSET, bytes + sizeof(T));
+    }
+
+    template <class T>
+    static Event* decodeTrivial(const char* data, size_t size) {
+        T* ev = new T();
+        std::memcpy(reinterpret_cast<char*>(ev) + DATA_OFFSET, data, sizeof(T) - DATA_OFFSET);
+        return ev;
+    }
+};
+
+} //namespace SST
+
+/** Register an Event type whose data members can be copied with memcpy,
+ * for use at file scope in the library that defines the Event */
+#define SST_WIRE_FORMAT_TRIVIAL_EVENT(type, id)                        \
+    namespace {                                                         \
+        struct SSTWireFormat_##id {                                     \
+            SSTWireFormat_##id() {                                      \
+                SST::EventWireFormat::registerTrivialType<type>(id);    \
+            }                                                           \
+        } sstWireFormat_##id;                                           \
+    }
+
+#endif // SST_CORE_EVENTWIREFORMAT_H
@@ -14,6 +14,8 @@
 #include "sst/core/serialization.h"
 #include "sst/core/exit.h"
 
+#include <thread>
+
 #ifdef SST_CONFIG_HAVE_MPI
 #include <mpi.h>
 #endif
@@ -33,7 +35,10 @@ Exit::Exit( int num_threads, TimeConverter* period, bool single_rank ) :
     m_refCount( 0 ),
     m_period( period ),
     end_time(0),
-    single_rank(single_rank)
+    m_threads_at_end(0),
+    m_end_reached(false),
+    single_rank(single_rank),
+    reduction(NULL)
 {
     setPriority(EXITPRIORITY);
     m_thread_counts = new unsigned int[num_threads];
@@ -104,37 +109,96 @@ bool Exit::refDec( ComponentId_t id, uint32_t thread )
 
     if ( single_rank && num_threads == 1 && m_refCount == 0 ) {
         // std::cout << "Exiting..." << std::endl;
-        end_time = Simulation::getSimulation()->getCurrentSimCycle();
+        end_time = Simulation::getThreadSimCycle();
         Simulation* sim = Simulation::getSimulation();
         // sim->insertActivity( sim->getCurrentSimCycle() + m_period->getFactor(), this );
         sim->insertActivity( sim->getCurrentSimCycle() + 1, this );
     }
     else if ( m_thread_counts[thread] == 0 ) {
-        SimTime_t end_time_new = Simulation::getSimulation()->getCurrentSimCycle();
+        SimTime_t end_time_new = Simulation::getThreadSimCycle();
         if ( end_time_new > end_time ) end_time = end_time_new;
     }    
         
     return false;
 }
 
+void Exit::refMove( ComponentId_t id, uint32_t from_thread, uint32_t to_thread )
+{
+    std::lock_guard<Spinlock> lock(slock);
+    if ( m_idSet.find( id ) == m_idSet.end() ) return;
+
+    --m_thread_counts[from_thread];
+    ++m_thread_counts[to_thread];
+}
+
 unsigned int Exit::getRefCount() {
+    std::lock_guard<Spinlock> lock(slock);
     return m_refCount;
 }
 
+SimTime_t Exit::getEndTime() {
+    std::lock_guard<Spinlock> lock(slock);
+    return end_time;
+}
+
+bool Exit::waitForEnd( SimTime_t now )
+{
+    {
+        std::lock_guard<Spinlock> lock(slock);
+        ++m_threads_at_end;
+    }
+    while ( true ) {
+        {
+            // References only change on threads that are not waiting
+            // here, so once all of them are, the answer is final
+            std::lock_guard<Spinlock> lock(slock);
+            if ( m_end_reached ) return true;
+            if ( m_refCount > 0 || now < end_time ) {
+                --m_threads_at_end;
+                return false;
+            }
+            if ( m_threads_at_end == num_threads ) {
+                m_end_reached = true;
+                return true;
+            }
+        }
+        std::this_thread::yield();
+    }
+}
+
 
 void
 Exit::execute()
 {
     check();
 
-    SimTime_t next = Simulation::getSimulation()->getCurrentSimCycle() + m_period->getFactor();
+    SimTime_t next = Simulation::getThreadSimCycle() + m_period->getFactor();
     Simulation::getSimulation()->insertActivity( next, this );
     
 }
     
 // bool Exit::handler( Event* e )
+void Exit::setReduction(GlobalReduction& reduction)
+{
+    this->reduction = &reduction;
+    active_field = reduction.addField(GlobalReduction::SUM);
+    end_time_field = reduction.addField(GlobalReduction::MAX);
+    reduction.addContributor([this](GlobalReduction& r) {
+            r.set(active_field, m_refCount > 0);
+            r.set(end_time_field, end_time);
+        });
+}
+
 void Exit::check( void )
 {
+    if ( reduction != NULL ) {
+        if ( reduction->get(active_field) == 0 ) {
+            end_time = reduction->get(end_time_field);
+            endSimulation(end_time);
+        }
+        return;
+    }
+
     int value = ( m_refCount > 0 );
     int out;
 
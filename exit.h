@@ -18,6 +18,7 @@
 #include <unordered_set>
 
 #include <sst/core/action.h>
+#include <sst/core/globalReduction.h>
 
 namespace SST{
 
@@ -54,13 +55,30 @@ public:
     bool refInc( ComponentId_t, uint32_t thread );
     /** Decrement Reference Count for a given Component ID */
     bool refDec( ComponentId_t, uint32_t thread );
+    /** Move the reference held by a Component (if any) to another
+     * thread, because the Component has moved there */
+    void refMove( ComponentId_t, uint32_t from_thread, uint32_t to_thread );
 
     unsigned int getRefCount();
-    SimTime_t getEndTime() { return end_time; }
+    SimTime_t getEndTime();
+
+    /** Used by thread syncs that let the threads of a single rank run
+     * at different times.  Called by a thread that has reached time
+     * now with no references held; waits there until either every
+     * thread has stopped at or after the end time (returns true, the
+     * simulation ends at getEndTime()) or this thread has to go on
+     * (returns false): a reference was taken again, or now is before
+     * the end time. */
+    bool waitForEnd( SimTime_t now );
     
     void execute(void);
     void check();
 
+    /** Add the reference count and end time to a reduction that is done
+     * before every call to check(), so check() needs no collectives of
+     * its own */
+    void setReduction(GlobalReduction& reduction);
+
     void print(const std::string& header, Output &out) const {
         out.output("%s Exit Action to be delivered at %" PRIu64 " with priority %d\n",
                 header.c_str(), getDeliveryTime(), getPriority());
@@ -80,10 +98,17 @@ private:
     TimeConverter*  m_period;
     std::unordered_set<ComponentId_t> m_idSet;
     SimTime_t end_time;
+    /** Threads waiting in waitForEnd() */
+    int m_threads_at_end;
+    bool m_end_reached;
 
     Core::ThreadSafe::Spinlock slock;
     
     bool single_rank;
+
+    GlobalReduction* reduction;
+    GlobalReduction::field_t active_field;
+    GlobalReduction::field_t end_time_field;
     
     friend class boost::serialization::access;
     template<class Archive>
@@ -0,0 +1,135 @@
+// Copyright 2009-2015 Sandia Corporation. Under the terms
+// of Contract DE-AC04-94AL85000 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2015, Sandia Corporation
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include "sst_config.h"
+#include "sst/core/globalReduction.h"
+
+#include <cfloat>
+
+#ifdef SST_CONFIG_HAVE_MPI
+#include <mpi.h>
+#endif
+
+namespace SST {
+
+namespace {
+
+// What goes over the wire for each field.  The operation travels with
+// the value, so the MPI_Op does not need to know the layout.
+struct Element {
+    uint32_t op;
+    uint32_t is_double;
+    union {
+        uint64_t u;
+        double d;
+    } value;
+};
+
+template <typename T>
+T combine(uint32_t op, T a, T b)
+{
+    switch ( op ) {
+    case GlobalReduction::MIN: return a < b ? a : b;
+    case GlobalReduction::MAX: return a > b ? a : b;
+    default: return a + b;
+    }
+}
+
+#ifdef SST_CONFIG_HAVE_MPI
+void reduceElements(void* invec, void* inoutvec, int* len, MPI_Datatype* datatype)
+{
+    Element* in = static_cast<Element*>(invec);
+    Element* inout = static_cast<Element*>(inoutvec);
+    for ( int i = 0; i < *len; i++ ) {
+        if ( in[i].is_double ) inout[i].value.d = combine(in[i].op, in[i].value.d, inout[i].value.d);
+        else inout[i].value.u = combine(in[i].op, in[i].value.u, inout[i].value.u);
+    }
+}
+
+// Created on first use, which is after MPI_Init
+bool mpi_types_created = false;
+MPI_Datatype element_type;
+MPI_Op element_op;
+#endif
+
+} // anonymous namespace
+
+GlobalReduction::field_t
+GlobalReduction::add(Op op, bool is_double)
+{
+    Field field;
+    field.op = op;
+    field.is_double = is_double;
+    // Start out at the identity of the operation, so a rank that never
+    // sets the field does not change the result
+    if ( is_double ) {
+        field.local.d = op == MIN ? DBL_MAX : op == MAX ? -DBL_MAX : 0.0;
+    }
+    else {
+        field.local.u = op == MIN ? MAX_SIMTIME_T : 0;
+    }
+    field.global = field.local;
+    fields.push_back(field);
+    return fields.size() - 1;
+}
+
+GlobalReduction::field_t
+GlobalReduction::addField(Op op)
+{
+    return add(op, false);
+}
+
+GlobalReduction::field_t
+GlobalReduction::addDoubleField(Op op)
+{
+    return add(op, true);
+}
+
+void
+GlobalReduction::addContributor(const Contributor& contributor)
+{
+    contributors.push_back(contributor);
+}
+
+void
+GlobalReduction::reduce()
+{
+    for ( size_t i = 0; i < contributors.size(); i++ ) {
+        contributors[i](*this);
+    }
+
+#ifdef SST_CONFIG_HAVE_MPI
+    if ( !mpi_types_created ) {
+        MPI_Type_contiguous(sizeof(Element), MPI_BYTE, &element_type);
+        MPI_Type_commit(&element_type);
+        MPI_Op_create(&reduceElements, 1, &element_op);
+        mpi_types_created = true;
+    }
+
+    std::vector<Element> input(fields.size());
+    std::vector<Element> output(fields.size());
+    for ( size_t i = 0; i < fields.size(); i++ ) {
+        input[i].op = fields[i].op;
+        input[i].is_double = fields[i].is_double;
+        input[i].value.u = fields[i].local.u;
+    }
+    MPI_Allreduce(input.data(), output.data(), fields.size(), element_type, element_op, MPI_COMM_WORLD);
+    for ( size_t i = 0; i < fields.size(); i++ ) {
+        fields[i].global.u = output[i].value.u;
+    }
+#else
+    for ( size_t i = 0; i < fields.size(); i++ ) {
+        fields[i].global = fields[i].local;
+    }
+#endif
+}
+
+} // namespace SST
@@ -0,0 +1,87 @@
+// Copyright 2009-2015 Sandia Corporation. Under the terms
+// of Contract DE-AC04-94AL85000 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2015, Sandia Corporation
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef SST_CORE_GLOBALREDUCTION_H
+#define SST_CORE_GLOBALREDUCTION_H
+
+#include <sst/core/sst_types.h>
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace SST {
+
+/**
+ * \class GlobalReduction
+ *
+ * A set of values that are reduced across all ranks with a single
+ * MPI_Allreduce.  Each field has its own operation, so values that
+ * would otherwise each need a collective (minimums, maximums and sums)
+ * share one.
+ *
+ * Fields must be added in the same order on every rank, and before the
+ * first reduce().  Only thread 0 may call reduce().
+ */
+class GlobalReduction {
+public:
+    enum Op { MIN, MAX, SUM };
+
+    typedef size_t field_t;
+    /** Called at the start of every reduce() to set this rank's values */
+    typedef std::function<void(GlobalReduction&)> Contributor;
+
+    GlobalReduction() {}
+    ~GlobalReduction() {}
+
+    /** Add an integer field and return its handle */
+    field_t addField(Op op);
+    /** Add a floating point field and return its handle */
+    field_t addDoubleField(Op op);
+    /** Add a callback that sets fields before each reduction */
+    void addContributor(const Contributor& contributor);
+
+    /** Set this rank's value of a field */
+    void set(field_t field, uint64_t value) { fields[field].local.u = value; }
+    void setDouble(field_t field, double value) { fields[field].local.d = value; }
+
+    /** Value of a field over all ranks, as of the last reduce() */
+    uint64_t get(field_t field) const { return fields[field].global.u; }
+    double getDouble(field_t field) const { return fields[field].global.d; }
+
+    /** Run the contributors and reduce every field across the ranks */
+    void reduce();
+
+private:
+    union Value {
+        uint64_t u;
+        double d;
+    };
+
+    struct Field {
+        Op op;
+        bool is_double;
+        Value local;
+        Value global;
+    };
+
+    std::vector<Field> fields;
+    std::vector<Contributor> contributors;
+
+    field_t add(Op op, bool is_double);
+
+    GlobalReduction(const GlobalReduction&);    // Don't implement
+    void operator=(GlobalReduction const&);     // Don't implement
+};
+
+} // namespace SST
+
+#endif // SST_CORE_GLOBALREDUCTION_H
@@ -18,9 +18,6 @@
 #include "sst/core/simulation.h"
 #include "sst/core/timeConverter.h"
 
-#ifdef SST_CONFIG_HAVE_MPI
-#include <mpi.h>
-#endif
 
 namespace SST {
 
@@ -29,6 +26,16 @@ SimulatorHeartbeat::SimulatorHeartbeat( Config* cfg, int this_rank, Simulation*
     rank(this_rank),
     m_period( period )
 {
+    max_tv_depth = reduction.addField(GlobalReduction::MAX);
+    max_sync_data_size = reduction.addField(GlobalReduction::MAX);
+    sync_data_size = reduction.addField(GlobalReduction::SUM);
+    max_mempool = reduction.addField(GlobalReduction::MAX);
+    total_mempool = reduction.addField(GlobalReduction::SUM);
+    total_active_activities = reduction.addField(GlobalReduction::SUM);
+    total_barrier_waits = reduction.addField(GlobalReduction::SUM);
+    total_barrier_wait_time = reduction.addDoubleField(GlobalReduction::SUM);
+    max_barrier_wait = reduction.addDoubleField(GlobalReduction::MAX);
+
     sim->insertActivity( period->getFactor(), this );
     if( (0 == this_rank) ) {
         lastTime = sst_get_cpu_time();
@@ -59,37 +66,42 @@ void SimulatorHeartbeat::execute( void )
     SimTime_t next = sim->getCurrentSimCycle() + m_period->getFactor();
     sim->insertActivity( next, this );
 
-    // Print some resource usage
-    uint64_t local_max_tv_depth = Simulation::getSimulation()->getTimeVortexMaxDepth();
-    uint64_t global_max_tv_depth;
-    
+    // Print some resource usage.  All the values go to the other ranks
+    // in one collective.
+    reduction.set(max_tv_depth, Simulation::getSimulation()->getTimeVortexMaxDepth());
+
     uint64_t local_sync_data_size = Simulation::getSimulation()->getSyncQueueDataSize();
-    uint64_t global_max_sync_data_size, global_sync_data_size;
+    reduction.set(max_sync_data_size, local_sync_data_size);
+    reduction.set(sync_data_size, local_sync_data_size);
 
-    uint64_t mempool_size;
-    uint64_t active_activities;
+    uint64_t mempool_size = 0;
+    uint64_t active_activities = 0;
 #ifdef USE_MEMPOOL
     Activity::getMemPoolUsage(mempool_size, active_activities);
 #endif
-    uint64_t max_mempool_size, global_mempool_size, global_active_activities;
-    
-#ifdef SST_CONFIG_HAVE_MPI
-    MPI_Allreduce(&local_max_tv_depth, &global_max_tv_depth, 1, MPI_UINT64_T, MPI_MAX, MPI_COMM_WORLD );
-    MPI_Allreduce(&local_sync_data_size, &global_max_sync_data_size, 1, MPI_UINT64_T, MPI_MAX, MPI_COMM_WORLD );
-    MPI_Allreduce(&local_sync_data_size, &global_sync_data_size, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD );
-    MPI_Allreduce(&mempool_size, &max_mempool_size, 1, MPI_UINT64_T, MPI_MAX, MPI_COMM_WORLD );
-    MPI_Allreduce(&mempool_size, &global_mempool_size, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD );
-    MPI_Allreduce(&active_activities, &global_active_activities, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD );
-#else
-    global_max_tv_depth = local_max_tv_depth;
-    global_max_sync_data_size = 0;
-    global_max_sync_data_size = 0;
-    max_mempool_size = mempool_size;
-    global_mempool_size = mempool_size;
-    global_active_activities = active_activities;
-#endif
+    reduction.set(max_mempool, mempool_size);
+    reduction.set(total_mempool, mempool_size);
+    reduction.set(total_active_activities, active_activities);
+
+    uint64_t barrier_waits;
+    double barrier_wait_time, max_barrier_wait_time;
+    Simulation::getBarrierWaitStats(barrier_waits, barrier_wait_time, max_barrier_wait_time);
+    reduction.set(total_barrier_waits, barrier_waits);
+    reduction.setDouble(total_barrier_wait_time, barrier_wait_time);
+    reduction.setDouble(max_barrier_wait, max_barrier_wait_time);
+
+    reduction.reduce();
+
+    uint64_t global_max_tv_depth = reduction.get(max_tv_depth);
+    uint64_t global_max_sync_data_size = reduction.get(max_sync_data_size);
+    uint64_t global_sync_data_size = reduction.get(sync_data_size);
+    uint64_t max_mempool_size = reduction.get(max_mempool);
+    uint64_t global_mempool_size = reduction.get(total_mempool);
+    uint64_t global_active_activities = reduction.get(total_active_activities);
+    uint64_t global_barrier_waits = reduction.get(total_barrier_waits);
+    double global_barrier_wait_time = reduction.getDouble(total_barrier_wait_time);
+    double global_max_barrier_wait_time = reduction.getDouble(max_barrier_wait);
 
-        
     if ( rank == 0 ) {
 	    char ua_buffer[256];
         
@@ -117,6 +129,10 @@ void SimulatorHeartbeat::execute( void )
                           global_max_sync_data_size_ua.toStringBestSI().c_str());
         sim_output.output("\tGlobal Sync data size:           %s\n",
                           global_sync_data_size_ua.toStringBestSI().c_str());
+        sim_output.output("\tMax thread barrier wait time:    %.5f seconds\n",
+                          global_max_barrier_wait_time);
+        sim_output.output("\tGlobal barrier wait time:        %.5f seconds (%" PRIu64 " waits)\n",
+                          global_barrier_wait_time, global_barrier_waits);
         
     }
 
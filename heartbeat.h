@@ -20,6 +20,7 @@
 
 #include <set>
 #include <sst/core/action.h>
+#include <sst/core/globalReduction.h>
 
 namespace SST {
 
@@ -46,6 +47,17 @@ private:
     int rank;
     TimeConverter*  m_period;
     double lastTime;
+
+    GlobalReduction reduction;
+    GlobalReduction::field_t max_tv_depth;
+    GlobalReduction::field_t max_sync_data_size;
+    GlobalReduction::field_t sync_data_size;
+    GlobalReduction::field_t max_mempool;
+    GlobalReduction::field_t total_mempool;
+    GlobalReduction::field_t total_active_activities;
+    GlobalReduction::field_t total_barrier_waits;
+    GlobalReduction::field_t total_barrier_wait_time;
+    GlobalReduction::field_t max_barrier_wait;
     
     friend class boost::serialization::access;
     template<class Archive>
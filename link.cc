@@ -20,6 +20,7 @@
 #include <sst/core/initQueue.h>
 #include <sst/core/pollingLinkQueue.h>
 #include <sst/core/simulation.h>
+#include <sst/core/statapi/statlinktraffic.h>
 #include <sst/core/timeConverter.h>
 #include <sst/core/timeLord.h>
 #include <sst/core/timeVortex.h>
@@ -36,6 +37,11 @@ Link::Link(LinkId_t id) :
     rFunctor( NULL ),
     defaultTimeBase( NULL ),
     latency(1),
+    delay_line(NULL),
+    suspend_list(NULL),
+    traffic(NULL),
+    sync_target(NULL),
+    sync_slot(-1),
     type(HANDLER),
     id(id)
 {
@@ -46,13 +52,18 @@ Link::Link(LinkId_t id) :
     
     recvQueue = uninitQueue;
     initQueue = NULL;
-    configuredQueue = Simulation::getSimulation()->getTimeVortex();
+    configuredQueue = Simulation::getThreadTimeVortex();
 }
 
 Link::Link() :
     rFunctor( NULL ),
     defaultTimeBase( NULL ),
     latency(1),
+    delay_line(NULL),
+    suspend_list(NULL),
+    traffic(NULL),
+    sync_target(NULL),
+    sync_slot(-1),
     type(HANDLER),
     id(-1)
 {
@@ -63,7 +74,7 @@ Link::Link() :
     
     recvQueue = uninitQueue;
     initQueue = NULL;
-    configuredQueue = Simulation::getSimulation()->getTimeVortex();
+    configuredQueue = Simulation::getThreadTimeVortex();
 }
 
 Link::~Link() {
@@ -71,12 +82,20 @@ Link::~Link() {
         delete recvQueue;
     }
     if ( rFunctor != NULL ) delete rFunctor;
+    if ( delay_line != NULL ) delete delay_line;
 }
 
 void Link::finalizeConfiguration() {
     // TraceFunction trace (CALL_INFO_LONG);
     recvQueue = configuredQueue;
     configuredQueue = NULL;
+    // Handler links that deliver into the TimeVortex get a delay line
+    // so only the earliest event on the link sits in the TimeVortex
+    TimeVortex* tv = Simulation::getThreadTimeVortex();
+    if ( type == HANDLER && recvQueue == tv ) {
+        delay_line = new LinkDelayLine(tv);
+        recvQueue = delay_line;
+    }
     if ( initQueue != NULL ) {
 	if ( dynamic_cast<InitQueue*>(initQueue) != NULL) {
 	    delete initQueue;
@@ -111,12 +130,15 @@ void Link::send( SimTime_t delay, TimeConverter* tc, Event* event ) {
         Simulation::getSimulation()->getSimulationOutput().fatal(CALL_INFO, -1, "Cannot send an event on Link with NULL TimeConverter\n");
     }
     
-    Cycle_t cycle = Simulation::getSimulation()->getCurrentSimCycle() +
+    Cycle_t cycle = Simulation::getThreadSimCycle() +
         tc->convertToCoreTime(delay) + latency;
     
     if ( event == NULL ) {
         event = new NullEvent();
     }
+    if ( UNLIKELY(traffic != NULL) ) {
+        traffic->record(Simulation::getThreadSimCycle(), event);
+    }
     event->setDeliveryTime(cycle);
     event->setDeliveryLink(id,pair_link);
 
@@ -128,16 +150,50 @@ void Link::send( SimTime_t delay, TimeConverter* tc, Event* event ) {
     // trace.getOutput().output(CALL_INFO, "%p\n",pair_link->recvQueue);
     pair_link->recvQueue->insert( event );
 }
+
+void Link::sendBatch( size_t count, const SimTime_t* delays, TimeConverter* tc, Event** events ) {
+    if ( tc == NULL ) {
+        Simulation::getSimulation()->getSimulationOutput().fatal(CALL_INFO, -1, "Cannot send an event on Link with NULL TimeConverter\n");
+    }
+
+    const SimTime_t base = Simulation::getThreadSimCycle() + latency;
+    const SimTime_t factor = tc->getFactor();
+    ActivityQueue* queue = pair_link->recvQueue;
+
+    // Hand the events over in chunks so no allocation is needed
+    const size_t chunk_size = 64;
+    Activity* chunk[chunk_size];
+    size_t i = 0;
+    while ( i < count ) {
+        size_t n = 0;
+        for ( ; n < chunk_size && i < count; n++, i++ ) {
+            Event* event = events[i];
+            if ( event == NULL ) {
+                event = new NullEvent();
+            }
+            if ( UNLIKELY(traffic != NULL) ) {
+                traffic->record(base - latency, event);
+            }
+            event->setDeliveryTime(base + delays[i] * factor);
+            event->setDeliveryLink(id,pair_link);
+#if __SST_DEBUG_EVENT_TRACKING__
+            event->addSendComponent(comp, ctype, port);
+            event->addRecvComponent(pair_link->comp, pair_link->ctype, pair_link->port);
+#endif
+            chunk[n] = event;
+        }
+        queue->insertBatch(chunk, n);
+    }
+}
     
 
 Event* Link::recv() 
 {
     Event* event = NULL;
-    Simulation *simulation = Simulation::getSimulation();
 
     if ( !recvQueue->empty() ) {
 	Activity* activity = recvQueue->front();
-	if ( activity->getDeliveryTime() <=  simulation->getCurrentSimCycle() ) {
+	if ( activity->getDeliveryTime() <= Simulation::getThreadSimCycle() ) {
 	    event = static_cast<Event*>(activity);
 	    recvQueue->pop();
 	}
@@ -145,6 +201,22 @@ Event* Link::recv()
     return event;
 } 
 
+size_t Link::recvAll(std::vector<Event*>& events)
+{
+    SimTime_t now = Simulation::getThreadSimCycle();
+    // Polling links get their events straight out of the ring
+    if ( type == POLL && recvQueue != uninitQueue ) {
+        return static_cast<PollingLinkQueue*>(recvQueue)->popReady(now, events);
+    }
+
+    size_t count = 0;
+    while ( !recvQueue->empty() && recvQueue->front()->getDeliveryTime() <= now ) {
+        events.push_back(static_cast<Event*>(recvQueue->pop()));
+        count++;
+    }
+    return count;
+}
+
 void Link::sendInitData(Event* init_data)
 {
     if ( pair_link->initQueue == NULL ) {
@@ -15,7 +15,11 @@
 #include <sst/core/sst_types.h>
 #include <sst/core/serialization.h>
 
+#include <sst/core/clock.h>
 #include <sst/core/event.h>
+#include <sst/core/linkDelayLine.h>
+
+#include <vector>
 // #include <sst/core/eventFunctor.h>
 
 namespace SST { 
@@ -29,18 +33,28 @@ class ActivityQueue;
 class SyncBase;
 
 class UnitAlgebra;
+namespace Statistics {
+    class LinkTrafficStatistic;
+}
  
   /** Link between two components. Carries events */
 class Link {
         typedef enum { POLL, HANDLER, QUEUE } Type_t;
 public:
 
+    friend class Component;
+    friend class Event;
     friend class LinkPair;
     friend class NewRankSync;
     friend class NewThreadSync;
+    friend class NullEvent;
     friend class Simulation;
     friend class SyncBase;
+    friend class SyncQueue;
     friend class ThreadSync;
+    friend class ThreadSyncDirectSkip;
+    friend class ThreadSyncSimpleSkip;
+    friend class ThreadSyncSkipBase;
     friend class SyncManager;
     
     /** Create a new link with a given ID */
@@ -96,6 +110,26 @@ public:
         send( 0, event );
     }
 
+    /** Send a batch of events, each with its own additional delay.
+      Same as calling send() for each event in array order, but the
+      events are handed to the receiving queue in one operation.
+      @param count Number of events
+      @param delays Additional delay for each event
+      @param tc Time converter to specify units for the delays
+      @param events The events to send (NULL entries send a NullEvent)
+      */
+    void sendBatch( size_t count, const SimTime_t* delays, TimeConverter* tc, Event** events );
+
+    /** Send a batch of events with delays in units of the Link's
+      default timebase
+      @param count Number of events
+      @param delays Additional delay for each event
+      @param events The events to send
+      */
+    inline void sendBatch( size_t count, const SimTime_t* delays, Event** events ) {
+        sendBatch(count, delays, defaultTimeBase, events);
+    }
+
 
     /** Retrieve a pending event from the Link. For links which do not
       have a set event handler, they can be polled with this function.
@@ -103,6 +137,14 @@ public:
     */
     Event* recv();
 
+    /** Retrieve all pending events that are ready for delivery.  For
+      links which do not have a set event handler.  The events are
+      appended to events in delivery order.
+      @param events Vector the events are appended to
+      @return number of events retrieved
+    */
+    size_t recvAll(std::vector<Event*>& events);
+
 
     /** Manually set the default detaulTimeBase
       @param tc TimeConverter object for the timebase */
@@ -112,6 +154,11 @@ public:
 
     /** Causes an event to be delivered to the registered callback */
     inline void deliverEvent(Event* event) {
+        // Any clock handlers the receiving component suspended wake
+        // up on delivery
+        if ( UNLIKELY(suspend_list != NULL && !suspend_list->empty()) ) {
+            suspend_list->wakeup();
+        }
         (*rFunctor)(event);
     }
 
@@ -178,6 +225,30 @@ private:
 
     void sendInitData_sync(Event* init_data);
     void finalizeConfiguration();
+
+    /** Called by the event being delivered so the delay line (if
+     * any) can move its next event into the TimeVortex */
+    inline void advanceDelayLine(Activity* delivered) {
+        if ( delay_line != NULL ) delay_line->advance(delivered);
+    }
+
+    /** Delivery FIFO for handler links (NULL for other links) */
+    LinkDelayLine* delay_line;
+    /** Suspended clock handlers of the owning component */
+    Clock::SuspendList* suspend_list;
+    /** Traffic counters for events sent on this link (NULL unless
+     * link statistics are enabled).  Owned by the Simulation */
+    Statistics::LinkTrafficStatistic* traffic;
+    /** For the sync side of a link that crosses threads, the sync
+     * side Link on the receiving thread that delivers its events, so
+     * they pick up that Link's receive latency (NULL until the thread
+     * sync has finalized its links) */
+    Link* sync_target;
+    /** For the sync side of a link that crosses ranks, the index of
+     * the link among those shared with the remote rank.  It is sent
+     * in place of the link id once the links are finalized (-1 until
+     * then). */
+    LinkId_t sync_slot;
     
     Type_t type;
     LinkId_t id;
@@ -0,0 +1,114 @@
+// Copyright 2009-2015 Sandia Corporation. Under the terms
+// of Contract DE-AC04-94AL85000 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+// 
+// Copyright (c) 2009-2015, Sandia Corporation
+// All rights reserved.
+// 
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include "sst_config.h"
+#include "sst/core/serialization.h"
+
+#include <iostream>
+
+#include <sst/core/linkDelayLine.h>
+#include <sst/core/timeVortex.h>
+
+namespace SST {
+
+LinkDelayLine::LinkDelayLine(TimeVortex* tv) :
+    ActivityQueue(),
+    tv(tv),
+    head(NULL),
+    tail(NULL)
+{}
+
+LinkDelayLine::~LinkDelayLine()
+{
+    // The head belongs to the TimeVortex, but anything still held
+    // needs to be deleted
+    for ( std::deque<Activity*>::iterator it = held.begin(); it != held.end(); ++it ) {
+        delete *it;
+    }
+    held.clear();
+}
+
+bool LinkDelayLine::empty()
+{
+    return head == NULL;
+}
+
+int LinkDelayLine::size()
+{
+    return head == NULL ? 0 : held.size() + 1;
+}
+
+void LinkDelayLine::insert(Activity* activity)
+{
+    activity->setQueueOrder(tv->reserveQueueOrder());
+    place(activity);
+}
+
+void LinkDelayLine::insertBatch(Activity** activities, size_t count)
+{
+    uint64_t order = tv->reserveQueueOrders(count);
+    for ( size_t i = 0; i < count; i++ ) {
+        activities[i]->setQueueOrder(order++);
+        place(activities[i]);
+    }
+}
+
+inline void LinkDelayLine::place(Activity* activity)
+{
+    if ( head == NULL ) {
+        head = tail = activity;
+        tv->insertOrdered(activity);
+    }
+    else if ( later(activity, tail) ) {
+        held.push_back(activity);
+        tv->addHeld();
+        tail = activity;
+    }
+    else {
+        tv->insertOrdered(activity);
+    }
+}
+
+void LinkDelayLine::promote()
+{
+    if ( held.empty() ) {
+        head = tail = NULL;
+        return;
+    }
+    head = held.front();
+    held.pop_front();
+    tv->removeHeld();
+    tv->insertOrdered(head);
+}
+
+void LinkDelayLine::release(std::vector<Activity*>& events)
+{
+    events.insert(events.end(), held.begin(), held.end());
+    tv->removeHeld(held.size());
+    held.clear();
+    head = tail = NULL;
+}
+
+Activity* LinkDelayLine::pop()
+{
+    std::cout << "ERROR: Events cannot be removed from a LinkDelayLine; they are delivered through the TimeVortex." << std::endl;
+    abort();
+}
+
+Activity* LinkDelayLine::front()
+{
+    return head;
+}
+
+} // namespace SST
+
+BOOST_CLASS_EXPORT_IMPLEMENT(SST::LinkDelayLine)
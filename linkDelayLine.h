@@ -0,0 +1,94 @@
+// Copyright 2009-2015 Sandia Corporation. Under the terms
+// of Contract DE-AC04-94AL85000 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+// 
+// Copyright (c) 2009-2015, Sandia Corporation
+// All rights reserved.
+// 
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef SST_CORE_LINKDELAYLINE_H
+#define SST_CORE_LINKDELAYLINE_H
+
+#include <sst/core/serialization.h>
+
+#include <cstdio> // For printf
+#include <deque>
+#include <vector>
+
+#include <sst/core/activityQueue.h>
+
+namespace SST {
+
+class TimeVortex;
+
+/**
+ * Receive queue for handler based links.
+ *
+ * Only the earliest in-flight event on the link (the head) is kept in
+ * the TimeVortex.  Events sent after it that sort no earlier than the
+ * last event on the line are held in a FIFO and the next one is moved
+ * into the TimeVortex when the head is delivered.  Events that would
+ * sort ahead of the end of the line (i.e. sent with a smaller extra
+ * delay) go straight into the TimeVortex.  Queue orders are reserved
+ * at send time, so delivery order is exactly the same as inserting
+ * every event into the TimeVortex directly.
+ */
+class LinkDelayLine : public ActivityQueue {
+public:
+    LinkDelayLine(TimeVortex* tv);
+    ~LinkDelayLine();
+
+    bool empty();
+    int size();
+    void insert(Activity* activity);
+    /** Queue orders for the whole batch are reserved at once, and only
+     * the events that cannot be held go into the TimeVortex */
+    void insertBatch(Activity** activities, size_t count);
+    Activity* pop();
+    Activity* front();
+
+    /** Called as an event from this line is delivered.  If it is
+     * the head, the next held event is moved into the TimeVortex. */
+    inline void advance(Activity* delivered) {
+        if ( delivered == head ) promote();
+    }
+
+    /** Hand the held events over to the caller and empty the line.
+     * The head stays in the TimeVortex. */
+    void release(std::vector<Activity*>& events);
+
+private:
+    LinkDelayLine() {} // For serialization only
+
+    void place(Activity* activity);
+    void promote();
+
+    TimeVortex* tv;
+    /** Event currently in the TimeVortex */
+    Activity* head;
+    /** Last event on the line (head if nothing is held) */
+    Activity* tail;
+    /** Events waiting for the head to be delivered */
+    std::deque<Activity*> held;
+
+    Activity::pq_less_time_priority later;
+
+    friend class boost::serialization::access;
+    template<class Archive>
+    void
+    serialize(Archive & ar, const unsigned int version )
+    {
+        printf("begin LinkDelayLine::serialize\n");
+        ar & BOOST_SERIALIZATION_BASE_OBJECT_NVP(ActivityQueue);
+        printf("end LinkDelayLine::serialize\n");
+    }
+};
+
+} //namespace SST
+
+BOOST_CLASS_EXPORT_KEY(SST::LinkDelayLine)
+
+#endif // SST_CORE_LINKDELAYLINE_H
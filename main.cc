@@ -26,6 +26,15 @@
 #include <iostream>
 #include <fstream>
 #include <signal.h>
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <sstream>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 #include <sst/core/activity.h>
 #include <sst/core/archive.h>
@@ -105,7 +114,200 @@ static void setupSignals(uint32_t threadRank)
 }
 
 
-static void dump_partition(Config& cfg, ConfigGraph* graph, const RankInfo &size) {
+/** CPU and NUMA node a simulation thread is bound to (-1 if not bound) */
+typedef struct {
+    int cpu;
+    int node;
+} ThreadPlacement_t;
+
+/** Parse a Linux style cpu list ("0-3,8,10-11").  Returns false if
+ * the list is malformed. */
+static bool parse_cpu_list(const std::string& list, std::vector<int>& cpus)
+{
+    std::stringstream ss(list);
+    std::string item;
+    while ( std::getline(ss, item, ',') ) {
+        if ( item.empty() || item == "\n" ) continue;
+        char* end;
+        long first = strtol(item.c_str(), &end, 10);
+        long last = first;
+        if ( end == item.c_str() || first < 0 ) return false;
+        if ( *end == '-' ) {
+            const char* start = end + 1;
+            last = strtol(start, &end, 10);
+            if ( end == start || last < first ) return false;
+        }
+        if ( *end != '\0' && *end != '\n' ) return false;
+        for ( long cpu = first; cpu <= last; cpu++ ) cpus.push_back((int)cpu);
+    }
+    return true;
+}
+
+/** Returns the NUMA node of every CPU the kernel reports, from sysfs.
+ * Empty if there is no NUMA information. */
+static std::map<int, int> read_cpu_nodes()
+{
+    std::map<int, int> nodes;
+#ifdef __linux__
+    for ( int node = 0; ; node++ ) {
+        std::ostringstream path;
+        path << "/sys/devices/system/node/node" << node << "/cpulist";
+        std::ifstream file(path.str().c_str());
+        if ( !file ) {
+            // Node numbers can have holes, but not many
+            if ( node > 64 ) break;
+            continue;
+        }
+        std::string list;
+        std::getline(file, list);
+        std::vector<int> cpus;
+        if ( !parse_cpu_list(list, cpus) ) continue;
+        for ( size_t i = 0; i < cpus.size(); i++ ) nodes[cpus[i]] = node;
+    }
+#endif
+    return nodes;
+}
+
+/** Work out which CPU each thread of this rank should run on, from
+ * the --thread-affinity option and the CPUs this process is allowed
+ * to use.  compact fills the CPUs of one NUMA node before moving to
+ * the next, scatter deals threads out across the NUMA nodes in turn.
+ * An explicit cpu list is used as given, one CPU per thread. */
+static std::vector<ThreadPlacement_t> compute_thread_placement(Config& cfg, const RankInfo& world_size)
+{
+    ThreadPlacement_t unbound = { -1, -1 };
+    std::vector<ThreadPlacement_t> placement(world_size.thread, unbound);
+    if ( cfg.thread_affinity == "none" ) return placement;
+
+#ifdef __linux__
+    cpu_set_t allowed_set;
+    CPU_ZERO(&allowed_set);
+    if ( sched_getaffinity(0, sizeof(allowed_set), &allowed_set) != 0 ) {
+        g_output.fatal(CALL_INFO, -1, "Unable to get the CPU affinity of the process\n");
+    }
+    std::vector<int> allowed;
+    for ( int cpu = 0; cpu < CPU_SETSIZE; cpu++ ) {
+        if ( CPU_ISSET(cpu, &allowed_set) ) allowed.push_back(cpu);
+    }
+
+    std::map<int, int> cpu_nodes = read_cpu_nodes();
+    // CPUs without NUMA information are all treated as node 0
+    std::map<int, std::vector<int> > node_cpus;
+    for ( size_t i = 0; i < allowed.size(); i++ ) {
+        std::map<int, int>::iterator n = cpu_nodes.find(allowed[i]);
+        node_cpus[n == cpu_nodes.end() ? 0 : n->second].push_back(allowed[i]);
+    }
+
+    std::vector<int> order;
+    if ( cfg.thread_affinity == "compact" ) {
+        for ( std::map<int, std::vector<int> >::iterator n = node_cpus.begin(); n != node_cpus.end(); ++n ) {
+            order.insert(order.end(), n->second.begin(), n->second.end());
+        }
+    }
+    else if ( cfg.thread_affinity == "scatter" ) {
+        for ( size_t i = 0; order.size() < allowed.size(); i++ ) {
+            for ( std::map<int, std::vector<int> >::iterator n = node_cpus.begin(); n != node_cpus.end(); ++n ) {
+                if ( i < n->second.size() ) order.push_back(n->second[i]);
+            }
+        }
+    }
+    else {
+        if ( !parse_cpu_list(cfg.thread_affinity, order) || order.empty() ) {
+            g_output.fatal(CALL_INFO, -1, "Unknown thread-affinity '%s', expected none, compact, scatter or a cpu list\n",
+                           cfg.thread_affinity.c_str());
+        }
+        if ( order.size() < world_size.thread ) {
+            g_output.fatal(CALL_INFO, -1, "thread-affinity lists %lu CPUs, but %u threads are needed\n",
+                           (unsigned long)order.size(), world_size.thread);
+        }
+        for ( size_t i = 0; i < order.size(); i++ ) {
+            if ( std::find(allowed.begin(), allowed.end(), order[i]) == allowed.end() ) {
+                g_output.fatal(CALL_INFO, -1, "thread-affinity CPU %d is not available to this process\n", order[i]);
+            }
+        }
+    }
+
+    // Ranks started on the same node without CPU masks of their own
+    // would all pick the same first CPUs, so each takes its own share
+    size_t offset = 0;
+#ifdef SST_CONFIG_HAVE_MPI
+    MPI_Comm node_comm;
+    MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &node_comm);
+    int node_rank;
+    int node_size;
+    MPI_Comm_rank(node_comm, &node_rank);
+    MPI_Comm_size(node_comm, &node_size);
+    std::vector<cpu_set_t> node_sets(node_size);
+    MPI_Allgather(&allowed_set, sizeof(cpu_set_t), MPI_BYTE,
+                  &node_sets[0], sizeof(cpu_set_t), MPI_BYTE, node_comm);
+    bool same_sets = true;
+    for ( int r = 0; r < node_size; r++ ) {
+        if ( !CPU_EQUAL(&node_sets[r], &allowed_set) ) same_sets = false;
+    }
+    if ( same_sets && (cfg.thread_affinity == "compact" || cfg.thread_affinity == "scatter") ) {
+        offset = (size_t)node_rank * world_size.thread;
+    }
+#endif
+
+    if ( order.size() < world_size.thread ) {
+        g_output.output("WARNING: %u threads are sharing %lu CPUs\n",
+                        world_size.thread, (unsigned long)order.size());
+    }
+    for ( uint32_t t = 0; t < world_size.thread; t++ ) {
+        int cpu = order[(offset + t) % order.size()];
+        std::map<int, int>::iterator n = cpu_nodes.find(cpu);
+        placement[t].cpu = cpu;
+        placement[t].node = (n == cpu_nodes.end()) ? -1 : n->second;
+    }
+
+#ifdef SST_CONFIG_HAVE_MPI
+    // Threads of different ranks must not end up on the same CPU
+    std::vector<int> mine(world_size.thread);
+    for ( uint32_t t = 0; t < world_size.thread; t++ ) mine[t] = placement[t].cpu;
+    std::vector<int> node_cpus_used(world_size.thread * node_size);
+    MPI_Allgather(&mine[0], world_size.thread, MPI_INT,
+                  &node_cpus_used[0], world_size.thread, MPI_INT, node_comm);
+    MPI_Comm_free(&node_comm);
+    for ( int r = 0; r < node_size; r++ ) {
+        if ( r == node_rank ) continue;
+        for ( uint32_t t = 0; t < world_size.thread; t++ ) {
+            int cpu = node_cpus_used[r * world_size.thread + t];
+            if ( std::find(mine.begin(), mine.end(), cpu) != mine.end() ) {
+                g_output.fatal(CALL_INFO, -1, "thread-affinity places threads of more than one rank on CPU %d; "
+                               "bind each rank to its own CPUs in the MPI launcher\n", cpu);
+            }
+        }
+    }
+#endif
+#else
+    g_output.fatal(CALL_INFO, -1, "thread-affinity is only supported on Linux\n");
+#endif
+    return placement;
+}
+
+/** Bind the calling thread to its CPU.  Memory is then first touched
+ * on that CPU's NUMA node, so this has to happen before the thread
+ * builds its Simulation. */
+static void bind_thread(uint32_t tid, const ThreadPlacement_t& placement)
+{
+    if ( placement.cpu < 0 ) return;
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(placement.cpu, &set);
+    int err = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    if ( err != 0 ) {
+        g_output.fatal(CALL_INFO, -1, "Unable to bind thread %u to CPU %d: %s\n",
+                       tid, placement.cpu, strerror(err));
+    }
+    g_output.verbose(CALL_INFO, 1, 0, "# Thread %u bound to CPU %d (NUMA node %d)\n",
+                     tid, placement.cpu, placement.node);
+#endif
+}
+
+
+static void dump_partition(Config& cfg, ConfigGraph* graph, const RankInfo &size,
+                           const std::vector<ThreadPlacement_t> &placement) {
 
 	///////////////////////////////////////////////////////////////////////	
 	// If the user asks us to dump the partionned graph.
@@ -121,6 +323,11 @@ static void dump_partition(Config& cfg, ConfigGraph* graph, const RankInfo &size
 
         for(uint32_t i = 0; i < size.rank; i++) {
             for ( uint32_t t = 0 ; t < size.thread ; t++ ) {
+                const ThreadPlacement_t& p = placement[i * size.thread + t];
+                if ( p.cpu >= 0 ) {
+                    graph_file << "Rank: " << i << "." << t << " Placement: cpu " << p.cpu
+                               << ", NUMA node " << p.node << std::endl;
+                }
                 graph_file << "Rank: " << i << "." << t << " Component List:" << std::endl;
 
                 RankInfo r(i, t);
@@ -194,6 +401,7 @@ typedef struct {
     Config *config;
     ConfigGraph *graph;
     SimTime_t min_part;
+    ThreadPlacement_t placement;
 
     // Time / stats information
     double build_time;
@@ -202,6 +410,12 @@ typedef struct {
     uint64_t max_tv_depth;
     uint64_t current_tv_depth;
     uint64_t sync_data_size;
+    uint64_t barrier_waits;
+    double barrier_wait_time;
+    double busy_time;
+    uint64_t balance_checks;
+    uint64_t balance_imbalanced;
+    uint64_t balance_moved;
 
 } SimThreadInfo_t;
 
@@ -209,6 +423,8 @@ typedef struct {
 static void start_simulation(uint32_t tid, SimThreadInfo_t &info, Core::ThreadSafe::Barrier &barrier)
 {
     info.myRank.thread = tid;
+    Core::ThreadSafe::Barrier::setThreadIndex(tid);
+    bind_thread(tid, info.placement);
     double start_build = sst_get_cpu_time();
 
     if ( tid ) {
@@ -347,6 +563,12 @@ static void start_simulation(uint32_t tid, SimThreadInfo_t &info, Core::ThreadSa
     info.current_tv_depth = sim->getTimeVortexCurrentDepth();
 //    info.sync_data_size = sim->getSyncQueueDataSize();
 
+    const Core::ThreadSafe::BarrierWaitStats& wait_stats = Core::ThreadSafe::Barrier::getThreadWaitStats();
+    info.barrier_waits = wait_stats.count.load();
+    info.barrier_wait_time = wait_stats.nanoseconds.load() * 1e-9;
+    info.busy_time = sim->getThreadBusyTime();
+    sim->getThreadBalanceChecks(info.balance_checks, info.balance_imbalanced, info.balance_moved);
+
     delete sim;
 
 }
@@ -422,6 +644,26 @@ main(int argc, char *argv[])
     
     g_output.verbose(CALL_INFO, 1, 0, "#main() My rank is (%u.%u), on %u/%u nodes/threads\n", myRank.rank,myRank.thread, world_size.rank, world_size.thread);
 
+#ifdef USE_MEMPOOL
+    // Set the arena options before any Activity is allocated
+    Core::MemPool::ArenaOptions& arenaOptions = Core::MemPool::getArenaOptions();
+    if ( cfg.mempool_hugepages == "none" ) {
+        arenaOptions.hugePages = Core::MemPool::HUGEPAGES_NONE;
+    }
+    else if ( cfg.mempool_hugepages == "thp" ) {
+        arenaOptions.hugePages = Core::MemPool::HUGEPAGES_TRANSPARENT;
+    }
+    else if ( cfg.mempool_hugepages == "explicit" ) {
+        arenaOptions.hugePages = Core::MemPool::HUGEPAGES_EXPLICIT;
+    }
+    else {
+        g_output.fatal(CALL_INFO, -1, "Unknown mempool-hugepages mode '%s', expected none, thp or explicit\n",
+                       cfg.mempool_hugepages.c_str());
+    }
+    arenaOptions.lazyCarve = cfg.mempool_lazy;
+    arenaOptions.numaLocal = cfg.mempool_numa;
+#endif
+
     // Get the memory before we create the graph
     const uint64_t pre_graph_create_rss = maxGlobalMemSize();
 
@@ -475,6 +717,20 @@ main(int argc, char *argv[])
     ////// End ConfigGraph Creation //////
 
 
+    ////// Thread Placement //////
+    // Every rank works out its own placement, since each may be given
+    // a different set of CPUs.  Rank 0 collects them all for the
+    // partition dump.
+    std::vector<ThreadPlacement_t> placement = compute_thread_placement(cfg, world_size);
+    std::vector<ThreadPlacement_t> all_placement(placement);
+#ifdef SST_CONFIG_HAVE_MPI
+    if ( world_size.rank > 1 ) {
+        if ( myRank.rank == 0 ) all_placement.resize(world_size.rank * world_size.thread);
+        MPI_Gather(&placement[0], 2 * world_size.thread, MPI_INT,
+                   &all_placement[0], 2 * world_size.thread, MPI_INT, 0, MPI_COMM_WORLD);
+    }
+#endif
+
     ////// Start Partitioning //////
     double start_part = sst_get_cpu_time();
 
@@ -530,7 +786,7 @@ main(int argc, char *argv[])
 
 
         // Output the partition information is user requests it
-        dump_partition(cfg, graph, world_size);
+        dump_partition(cfg, graph, world_size, all_placement);
     }
 
     ////// End Partitioning //////
@@ -670,6 +926,16 @@ main(int argc, char *argv[])
     Simulation::factory = factory;
     Simulation::statisticsOutput = so;
     Simulation::sim_output = g_output;
+    if ( cfg.thread_barrier == "central" ) {
+        Core::ThreadSafe::Barrier::setDefaultType(Core::ThreadSafe::Barrier::CENTRAL);
+    }
+    else if ( cfg.thread_barrier == "dissemination" ) {
+        Core::ThreadSafe::Barrier::setDefaultType(Core::ThreadSafe::Barrier::DISSEMINATION);
+    }
+    else {
+        g_output.fatal(CALL_INFO, -1, "Unknown thread-barrier '%s', expected central or dissemination\n",
+                       cfg.thread_barrier.c_str());
+    }
     Simulation::barrier.resize(world_size.thread);
     /* Estimate that we won't have more than 128 sizes of events */
     Activity::memPools.reserve(world_size.thread * 128);
@@ -683,6 +949,7 @@ main(int argc, char *argv[])
         threadInfo[i].config = &cfg;
         threadInfo[i].graph = graph;
         threadInfo[i].min_part = min_part;
+        threadInfo[i].placement = placement[i];
     }
 
     double end_serial_build = sst_get_cpu_time();
@@ -703,6 +970,26 @@ main(int argc, char *argv[])
 
     double total_end_time = sst_get_cpu_time();
 
+    uint64_t local_barrier_waits = 0, global_barrier_waits = 0;
+    double local_barrier_wait_time = 0, global_barrier_wait_time = 0;
+    double local_max_barrier_wait_time = 0, max_barrier_wait_time = 0;
+    for ( uint32_t i = 0 ; i < world_size.thread ; i++ ) {
+        local_barrier_waits += threadInfo[i].barrier_waits;
+        local_barrier_wait_time += threadInfo[i].barrier_wait_time;
+        local_max_barrier_wait_time = std::max(local_max_barrier_wait_time, threadInfo[i].barrier_wait_time);
+    }
+
+    // Ratio of the busiest thread's time between syncs to the average,
+    // 1 when the threads of the rank are perfectly balanced
+    double local_busy_time = 0, local_max_busy_time = 0;
+    for ( uint32_t i = 0 ; i < world_size.thread ; i++ ) {
+        local_busy_time += threadInfo[i].busy_time;
+        local_max_busy_time = std::max(local_max_busy_time, threadInfo[i].busy_time);
+    }
+    double local_load_imbalance = 1.0, max_load_imbalance = 1.0;
+    if ( local_busy_time > 0.0 ) local_load_imbalance = local_max_busy_time * world_size.thread / local_busy_time;
+    uint64_t global_balance_checks = 0, global_balance_imbalanced = 0, global_balance_moved = 0;
+
     for ( uint32_t i = 1 ; i < world_size.thread ; i++ ) {
         threadInfo[0].simulated_time = std::max(threadInfo[0].simulated_time, threadInfo[i].simulated_time);
         threadInfo[0].run_time = std::max(threadInfo[0].run_time, threadInfo[i].run_time);
@@ -746,6 +1033,13 @@ main(int argc, char *argv[])
     MPI_Allreduce(&mempool_size, &max_mempool_size, 1, MPI_UINT64_T, MPI_MAX, MPI_COMM_WORLD );
     MPI_Allreduce(&mempool_size, &global_mempool_size, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD );
     MPI_Allreduce(&active_activities, &global_active_activities, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD );
+    MPI_Allreduce(&local_barrier_waits, &global_barrier_waits, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD );
+    MPI_Allreduce(&local_barrier_wait_time, &global_barrier_wait_time, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
+    MPI_Allreduce(&local_max_barrier_wait_time, &max_barrier_wait_time, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD );
+    MPI_Allreduce(&local_load_imbalance, &max_load_imbalance, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD );
+    MPI_Allreduce(&threadInfo[0].balance_checks, &global_balance_checks, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD );
+    MPI_Allreduce(&threadInfo[0].balance_imbalanced, &global_balance_imbalanced, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD );
+    MPI_Allreduce(&threadInfo[0].balance_moved, &global_balance_moved, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD );
 #else
     max_build_time = build_time;
     max_run_time = run_time;
@@ -757,6 +1051,13 @@ main(int argc, char *argv[])
     max_mempool_size = mempool_size;
     global_mempool_size = mempool_size;
     global_active_activities = active_activities;
+    global_barrier_waits = local_barrier_waits;
+    global_barrier_wait_time = local_barrier_wait_time;
+    max_barrier_wait_time = local_max_barrier_wait_time;
+    max_load_imbalance = local_load_imbalance;
+    global_balance_checks = threadInfo[0].balance_checks;
+    global_balance_imbalanced = threadInfo[0].balance_imbalanced;
+    global_balance_moved = threadInfo[0].balance_moved;
 #endif
 
     const uint64_t local_max_rss     = maxLocalMemSize();
@@ -794,6 +1095,17 @@ main(int argc, char *argv[])
         g_output.verbose(CALL_INFO, 1, 0, "Simulation time:                 %f seconds\n", max_run_time);
         g_output.verbose(CALL_INFO, 1, 0, "Total time:                      %f seconds\n", max_total_time);
         g_output.verbose(CALL_INFO, 1, 0, "Simulated time:                  %s\n", threadInfo[0].simulated_time.toStringBestSI().c_str());
+        g_output.verbose(CALL_INFO, 1, 0, "Max thread barrier wait time:    %f seconds\n", max_barrier_wait_time);
+        g_output.verbose(CALL_INFO, 1, 0, "Global barrier wait time:        %f seconds\n", global_barrier_wait_time);
+        g_output.verbose(CALL_INFO, 1, 0, "Global barrier waits:            %" PRIu64 " waits\n", global_barrier_waits);
+        if ( world_size.thread > 1 ) {
+            g_output.verbose(CALL_INFO, 1, 0, "Max thread load imbalance:       %f (busiest / average)\n", max_load_imbalance);
+            if ( cfg.thread_balance_threshold > 0.0 ) {
+                g_output.verbose(CALL_INFO, 1, 0, "Imbalanced balance checks:       %" PRIu64 " of %" PRIu64 "\n",
+                                 global_balance_imbalanced, global_balance_checks);
+                g_output.verbose(CALL_INFO, 1, 0, "Components moved:                %" PRIu64 "\n", global_balance_moved);
+            }
+        }
         g_output.verbose(CALL_INFO, 1, 0, "\n");
         g_output.verbose(CALL_INFO, 1, 0, "Simulation Resource Information:\n");
         g_output.verbose(CALL_INFO, 1, 0, "Max Resident Set Size:           %s\n",
@@ -14,12 +14,18 @@
 
 #include <list>
 #include <deque>
+#include <thread>
+#include <vector>
 
 #include <cstddef>
 #include <cstdlib>
 #include <cstring>
 #include <stdint.h>
 #include <sys/mman.h>
+#if defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 #include "sst/core/threadsafe.h"
 
@@ -49,53 +55,106 @@ class MemPool
             return p;
         }
 
+        /** Insert count entries with a single lock acquisition */
+        inline void insert_bulk(void **ptrs, size_t count) {
+            std::lock_guard<LOCK_t> lock(mtx);
+            list.insert(list.end(), ptrs, ptrs + count);
+        }
+
+        /** Remove up to max entries with a single lock acquisition
+         * @return number of entries written to ptrs */
+        inline size_t remove_bulk(void **ptrs, size_t max) {
+            std::lock_guard<LOCK_t> lock(mtx);
+            size_t count = list.size() < max ? list.size() : max;
+            if ( count == 0 ) return 0;
+            std::memcpy(ptrs, &list[list.size() - count], count * sizeof(void*));
+            list.resize(list.size() - count);
+            return count;
+        }
+
         size_t size() const { return list.size(); }
     };
 
 
+    /** Number of free elements cached by the owning thread */
+    static const size_t MAGAZINE_SIZE = 64;
+
 public:
-    /** Create a new Memory Pool.
+    /** Page size used for new arenas */
+    typedef enum {
+        HUGEPAGES_NONE,         /*!< Normal pages */
+        HUGEPAGES_TRANSPARENT,  /*!< Ask for transparent huge pages with madvise() */
+        HUGEPAGES_EXPLICIT      /*!< Map from the reserved huge page pool (MAP_HUGETLB) */
+    } HugePages_t;
+
+    /** Settings applied to arenas allocated after they are changed */
+    struct ArenaOptions {
+        HugePages_t hugePages;
+        /** Hand out slots with a bump pointer instead of filling the
+         * free list (and touching every page) when the arena is mapped */
+        bool lazyCarve;
+        /** Prefer the NUMA node of the thread that maps the arena */
+        bool numaLocal;
+    };
+
+    static ArenaOptions& getArenaOptions() {
+        static ArenaOptions options = { HUGEPAGES_NONE, false, false };
+        return options;
+    }
+
+    /** Create a new Memory Pool.  The calling thread becomes the owner
+     * of the pool and is the only thread that may allocate from it.
      * @param elementSize - Size of each Element
      * @param initialSize - Size of the memory pool (in bytes)
      */
 	MemPool(size_t elementSize, size_t initialSize=(2<<20)) :
         numAlloc(0), numFree(0),
         elemSize(elementSize), arenaSize(initialSize),
-        allocating(false)
+        owner(std::this_thread::get_id()),
+        magazineCount(0),
+        carveNext(NULL), carveEnd(NULL),
+        allocating(false),
+        returnStack(NULL)
     {
         allocPool();
     }
 
 	~MemPool()
     {
+        // Arenas come from mapArena(), so they go back with munmap
         for ( std::list<uint8_t*>::iterator i = arenas.begin() ; i != arenas.end() ; ++i ) {
-            ::free(*i);
+            munmap(*i, arenaSize);
         }
     }
 
-    /** Allocate a new element from the memory pool */
+    /** returnStack is CACHE_ALIGNED, which plain new does not honour */
+    static void* operator new(size_t size) { return ThreadSafe::allocCacheAligned(size); }
+    static void operator delete(void* ptr) { ::free(ptr); }
+
+    /** Allocate a new element from the memory pool.  Must be called
+     * by the owning thread. */
 	inline void* malloc()
     {
-        void *ret = freeList.try_remove();
-        while ( !ret ) {
-            bool ok = allocPool();
-            if ( !ok ) return NULL;
-            _mm_pause();
-            ret = freeList.try_remove();
-        }
-        ++numAlloc;
-        return ret;
+        if ( magazineCount == 0 && !refillMagazine() ) return NULL;
+        numAlloc++;
+        return magazine[--magazineCount];
     }
 
     /** Return an element to the memory pool */
 	inline void free(void *ptr)
     {
         // TODO:  Make sure this is in one of our arenas
-        freeList.insert(ptr);
+        if ( std::this_thread::get_id() == owner ) {
+            if ( magazineCount == MAGAZINE_SIZE ) spillMagazine();
+            magazine[magazineCount++] = ptr;
+            numFree++;
+        }
+        else {
+            remoteFree(ptr);
+        }
 // #ifdef __SST_DEBUG_EVENT_TRACKING__
 //         *((uint64_t*)ptr) = 0xFFFFFFFFFFFFFFFF;
 // #endif
-        ++numFree;
     }
 
     /**
@@ -112,18 +171,149 @@ public:
         return numAlloc - numFree;
     }
     
-    /** Counter:  Number of times elements have been allocated */
-    std::atomic<uint64_t> numAlloc;
-    /** Counter:  Number times elements have been freed */
-    std::atomic<uint64_t> numFree;
+    /** Counter:  Number of times elements have been allocated.  Only
+     * updated by the owner. */
+    uint64_t numAlloc;
+    /** Counter:  Number times elements have been freed.  Only updated
+     * by the owner; frees from other threads are counted when the
+     * owner takes them off the return stack. */
+    uint64_t numFree;
 
     size_t getArenaSize() const { return arenaSize; }
     size_t getElementSize() const { return elemSize; }
 
     const std::list<uint8_t*>& getArenas() { return arenas; }
+
+    /** Number of slots of an arena that have ever been handed out */
+    size_t getCarvedElements(const uint8_t* arena) const {
+        if ( !arenas.empty() && arena == arenas.back() ) {
+            return (carveNext - arena) / elemSize;
+        }
+        return arenaSize / elemSize;
+    }
     
 private:
 
+    /** Push an element freed by another thread onto the return stack.
+     * The link is kept in the element's second word; the first word
+     * is used by Activity to track undeleted entries. */
+    void remoteFree(void *ptr)
+    {
+        void **link = ((void**)ptr) + 1;
+        void *head = returnStack.load(std::memory_order_relaxed);
+        do {
+            *link = head;
+        } while ( !returnStack.compare_exchange_weak(head, ptr,
+                      std::memory_order_release,
+                      std::memory_order_relaxed) );
+    }
+
+    /** Take everything other threads have returned.  Fills the
+     * magazine first and moves any overflow to the free list. */
+    void drainReturnStack()
+    {
+        void *ptr = returnStack.exchange(NULL, std::memory_order_acquire);
+        if ( ptr == NULL ) return;
+        std::vector<void*> overflow;
+        while ( ptr != NULL ) {
+            void *next = *(((void**)ptr) + 1);
+            if ( magazineCount < MAGAZINE_SIZE ) magazine[magazineCount++] = ptr;
+            else overflow.push_back(ptr);
+            numFree++;
+            ptr = next;
+        }
+        if ( !overflow.empty() ) freeList.insert_bulk(overflow.data(), overflow.size());
+    }
+
+    /** Refill the magazine with elements returned by other threads,
+     * or else half of it from the shared free list, allocating a new
+     * arena if the free list is empty */
+    bool refillMagazine()
+    {
+        drainReturnStack();
+        if ( magazineCount > 0 ) return true;
+        magazineCount = freeList.remove_bulk(magazine, MAGAZINE_SIZE / 2);
+        while ( magazineCount == 0 ) {
+            magazineCount = carve(magazine, MAGAZINE_SIZE / 2);
+            if ( magazineCount > 0 ) break;
+            bool ok = allocPool();
+            if ( !ok ) return false;
+            _mm_pause();
+            magazineCount = freeList.remove_bulk(magazine, MAGAZINE_SIZE / 2);
+        }
+        return true;
+    }
+
+    /** Move the older half of a full magazine to the shared free list */
+    void spillMagazine()
+    {
+        const size_t half = MAGAZINE_SIZE / 2;
+        freeList.insert_bulk(magazine, half);
+        std::memmove(magazine, magazine + half, (magazineCount - half) * sizeof(void*));
+        magazineCount -= half;
+    }
+
+    /** Hand out up to max never used slots of the current arena */
+    size_t carve(void **ptrs, size_t max)
+    {
+        size_t count = 0;
+        while ( count < max && carveNext < carveEnd ) {
+            ptrs[count++] = carveNext;
+            carveNext += elemSize;
+        }
+        return count;
+    }
+
+    /** Map a new arena according to the ArenaOptions */
+    uint8_t* mapArena()
+    {
+        const ArenaOptions& options = getArenaOptions();
+        uint8_t *newPool = NULL;
+#ifdef MAP_HUGETLB
+        if ( options.hugePages == HUGEPAGES_EXPLICIT ) {
+            // Falls back to normal pages if no huge pages are reserved
+            void *ptr = mmap(0, arenaSize, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANON|MAP_HUGETLB, -1, 0);
+            if ( MAP_FAILED != ptr ) newPool = (uint8_t*)ptr;
+        }
+#endif
+#ifdef MADV_HUGEPAGE
+        if ( newPool == NULL && options.hugePages == HUGEPAGES_TRANSPARENT ) {
+            // Over-map so the arena can start on a huge page boundary
+            const size_t hugeSize = 2 << 20;
+            void *ptr = mmap(0, arenaSize + hugeSize, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANON, -1, 0);
+            if ( MAP_FAILED == ptr ) return NULL;
+            uintptr_t base = (uintptr_t)ptr;
+            uintptr_t start = (base + hugeSize - 1) & ~(uintptr_t)(hugeSize - 1);
+            if ( start > base ) munmap(ptr, start - base);
+            size_t tail = (base + arenaSize + hugeSize) - (start + arenaSize);
+            if ( tail > 0 ) munmap((void*)(start + arenaSize), tail);
+            newPool = (uint8_t*)start;
+            madvise(newPool, arenaSize, MADV_HUGEPAGE);
+        }
+#endif
+        if ( newPool == NULL ) {
+            void *ptr = mmap(0, arenaSize, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANON, -1, 0);
+            if ( MAP_FAILED == ptr ) return NULL;
+            newPool = (uint8_t*)ptr;
+        }
+        if ( options.numaLocal ) bindToLocalNode(newPool, arenaSize);
+        return newPool;
+    }
+
+    /** Set a preferred-node memory policy for the arena, before any of
+     * its pages are touched, using the node this thread is running on */
+    static void bindToLocalNode(void *addr, size_t len)
+    {
+#if defined(__linux__) && defined(SYS_mbind) && defined(SYS_getcpu)
+        const int mpolPreferred = 1; /* MPOL_PREFERRED from numaif.h */
+        unsigned int cpu, node;
+        if ( syscall(SYS_getcpu, &cpu, &node, NULL) != 0 ) return;
+        if ( node >= 8 * sizeof(unsigned long) ) return;
+        unsigned long mask = 1UL << node;
+        syscall(SYS_mbind, addr, len, mpolPreferred, &mask, 8 * sizeof(unsigned long) + 1, 0);
+#endif
+    }
+
 	bool allocPool()
     {
         /* If already in progress, return */
@@ -131,22 +321,32 @@ private:
             return true;
         }
 
-        uint8_t *newPool = (uint8_t*)mmap(0, arenaSize, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANON, -1, 0);
-        if ( MAP_FAILED == newPool ) {
+        uint8_t *newPool = mapArena();
+        if ( NULL == newPool ) {
             allocating.store(0, std::memory_order_release);
             return false;
         }
-        std::memset(newPool, 0xFF, arenaSize); 
         arenas.push_back(newPool);
         size_t nelem = arenaSize / elemSize;
+        carveEnd = newPool + (nelem * elemSize);
+        if ( getArenaOptions().lazyCarve ) {
+            // Slots are carved off as the owner needs them, so pages
+            // are first touched by the owner when they are first used
+            carveNext = newPool;
+            allocating.store(0, std::memory_order_release);
+            return true;
+        }
+        carveNext = carveEnd;
+        std::memset(newPool, 0xFF, arenaSize); 
+        std::vector<void*> slots(nelem);
         for ( size_t i = 0 ; i < nelem ; i++ ) {
             uint64_t* ptr = (uint64_t*)(newPool + (elemSize*i));
 // #ifdef __SST_DEBUG_EVENT_TRACKING__
 //             *ptr = 0xFFFFFFFFFFFFFFFF;
 // #endif
-            freeList.insert(ptr);
-            // freeList.push_back(newPool + (elemSize*i));
+            slots[i] = ptr;
         }
+        freeList.insert_bulk(slots.data(), nelem);
         allocating.store(0, std::memory_order_release);
         return true;
     }
@@ -154,10 +354,24 @@ private:
 	size_t elemSize;
 	size_t arenaSize;
 
+    /** Thread which created the pool and allocates from it */
+    std::thread::id owner;
+    /** Free elements only touched by the owner, no locking needed */
+    void* magazine[MAGAZINE_SIZE];
+    size_t magazineCount;
+    /** Next never used slot of the newest arena, and its end */
+    uint8_t* carveNext;
+    uint8_t* carveEnd;
+
     std::atomic<unsigned int> allocating;
 	FreeList<ThreadSafe::Spinlock> freeList;
 	std::list<uint8_t*> arenas;
 
+    /** Lock-free stack of elements freed by other threads, drained
+     * by the owner when its magazine runs dry.  Kept on its own cache
+     * line (last, so the padding is at the end of the object) so
+     * remote frees do not touch the owner's counters and magazine. */
+    CACHE_ALIGNED(std::atomic<void*>, returnStack);
 };
 
 }
@@ -75,6 +75,54 @@ void OneShot::registerHandler(OneShot::HandlerBase* handler)
     m_HandlerVectorMap[nextEventTime] = ptrHandlerList; 
 }
 
+void OneShot::registerHandlerAt(SimTime_t time, OneShot::HandlerBase* handler)
+{
+    HandlerVectorMap_t::iterator it = m_HandlerVectorMap.find(time);
+    if ( it == m_HandlerVectorMap.end() ) {
+        // Nothing is due at that time yet, so the OneShot also needs
+        // to go into the TimeVortex for it
+        it = m_HandlerVectorMap.insert(std::make_pair(time, new HandlerList_t())).first;
+        Simulation::getSimulation()->insertActivity(time, this);
+        m_scheduled = true;
+    }
+    it->second->push_back(handler);
+}
+
+void OneShot::removeHandlers(Component* comp, std::vector<std::pair<SimTime_t, OneShot::HandlerBase*> >& removed)
+{
+    for ( HandlerVectorMap_t::iterator m_it = m_HandlerVectorMap.begin(); m_it != m_HandlerVectorMap.end(); ) {
+        HandlerList_t* ptrHandlerList = m_it->second;
+        for ( HandlerList_t::iterator v_it = ptrHandlerList->begin(); v_it != ptrHandlerList->end(); ) {
+            if ( (*v_it)->owner == comp ) {
+                removed.push_back(std::make_pair(m_it->first, *v_it));
+                v_it = ptrHandlerList->erase(v_it);
+            }
+            else {
+                ++v_it;
+            }
+        }
+        // The OneShot stays in the TimeVortex and finds nothing to do
+        // at a time whose list is gone
+        if ( ptrHandlerList->empty() ) {
+            delete ptrHandlerList;
+            m_HandlerVectorMap.erase(m_it++);
+        }
+        else {
+            ++m_it;
+        }
+    }
+}
+
+bool OneShot::hasUnownedHandlers() const
+{
+    for ( HandlerVectorMap_t::const_iterator m_it = m_HandlerVectorMap.begin(); m_it != m_HandlerVectorMap.end(); ++m_it ) {
+        for ( HandlerList_t::const_iterator v_it = m_it->second->begin(); v_it != m_it->second->end(); ++v_it ) {
+            if ( (*v_it)->owner == NULL ) return true;
+        }
+    }
+    return false;
+}
+
 SimTime_t OneShot::scheduleOneShot()
 {
     // Add an event in the future into the TimeVortex for when 
@@ -22,6 +22,7 @@
 
 namespace SST {
 
+class Component;
 class TimeConverter;
 
 /**
@@ -37,9 +38,19 @@ public:
     /** Functor classes for OneShot handling */
     class HandlerBase {
     public:
+        HandlerBase() : owner(NULL) {}
+
         /** Function called when Handler is invoked */
         virtual void operator()() = 0;
         virtual ~HandlerBase() {}
+
+    private:
+        friend class Component;
+        friend class OneShot;
+
+        /** Component that registered the handler (NULL for handlers
+         * registered by the core) */
+        Component* owner;
     };
 
     /////////////////////////////////////////////////
@@ -123,6 +134,20 @@ public:
     /** Add a handler to be called on this OneShot Event */
     void registerHandler(OneShot::HandlerBase* handler);
 
+    /** Add a handler to be called at the given time rather than one
+     * delay from now.  Used to re-register handlers removed with
+     * removeHandlers() on another thread. */
+    void registerHandlerAt(SimTime_t time, OneShot::HandlerBase* handler);
+
+    /** Remove the handlers registered by comp that have not been
+     * called yet and append them to removed, with the time each one
+     * was to be called. */
+    void removeHandlers(Component* comp, std::vector<std::pair<SimTime_t, OneShot::HandlerBase*> >& removed);
+
+    /** Return true if any handler not yet called was registered
+     * directly with the Simulation rather than by a Component */
+    bool hasUnownedHandlers() const;
+
     /** Print details about the OneShot */
     void print(const std::string& header, Output &out) const;
     
@@ -15,46 +15,98 @@
 
 #include <sst/core/pollingLinkQueue.h>
 
+#include <sst/core/event.h>
+
 namespace SST {
 
-    PollingLinkQueue::PollingLinkQueue() : ActivityQueue() {}
+    PollingLinkQueue::PollingLinkQueue() :
+	ActivityQueue(),
+	data(16, NULL),
+	head(0),
+	count(0)
+    {}
+
     PollingLinkQueue::~PollingLinkQueue() {
 	// Need to delete any events left in the queue
-	std::multiset<Activity*,Activity::less_time>::iterator it;
-	for ( it = data.begin(); it != data.end(); ++it ) {
-	    delete *it;
+	for ( size_t i = 0; i < count; i++ ) {
+	    delete data[slot(i)];
 	}
 	data.clear();
     }
 
     bool PollingLinkQueue::empty()
     {
-	return data.empty();
+	return count == 0;
     }
     
     int PollingLinkQueue::size()
     {
-	return data.size();
+	return count;
     }
     
     void PollingLinkQueue::insert(Activity* activity)
     {
-	data.insert(activity);
+	if ( count == data.size() ) grow();
+
+	// Common case, arrives in time order
+	SimTime_t time = activity->getDeliveryTime();
+	if ( count == 0 || data[slot(count - 1)]->getDeliveryTime() <= time ) {
+	    data[slot(count)] = activity;
+	    count++;
+	    return;
+	}
+
+	// Find the first entry with a later delivery time, searching
+	// back from the tail, and shift the tail up one slot
+	size_t pos = count - 1;
+	while ( pos > 0 && data[slot(pos - 1)]->getDeliveryTime() > time ) {
+	    pos--;
+	}
+	for ( size_t i = count; i > pos; i-- ) {
+	    data[slot(i)] = data[slot(i - 1)];
+	}
+	data[slot(pos)] = activity;
+	count++;
     }
     
     Activity* PollingLinkQueue::pop()
     {
-	if ( data.size() == 0 ) return NULL;
-	std::multiset<Activity*,Activity::less_time>::iterator it = data.begin();
-	Activity* ret_val = (*it);
-	data.erase(it);
+	if ( count == 0 ) return NULL;
+	Activity* ret_val = data[head];
+	data[head] = NULL;
+	head = slot(1);
+	count--;
 	return ret_val;
     }
 
     Activity* PollingLinkQueue::front()
     {
-	if ( data.size() == 0 ) return NULL;
-	return *data.begin();
+	if ( count == 0 ) return NULL;
+	return data[head];
+    }
+
+    size_t PollingLinkQueue::popReady(SimTime_t time, std::vector<Event*>& events)
+    {
+	size_t n = 0;
+	while ( n < count && data[slot(n)]->getDeliveryTime() <= time ) {
+	    events.push_back(static_cast<Event*>(data[slot(n)]));
+	    data[slot(n)] = NULL;
+	    n++;
+	}
+	head = slot(n);
+	count -= n;
+	return n;
+    }
+
+    void PollingLinkQueue::grow()
+    {
+	// Unroll into a buffer twice the size, starting at slot 0
+	std::vector<Activity*> bigger(data.size() * 2, NULL);
+	for ( size_t i = 0; i < count; i++ ) {
+	    bigger[i] = data[slot(i)];
+	}
+	data.swap(bigger);
+	head = 0;
     }
 
 
@@ -15,14 +15,21 @@
 #include <sst/core/serialization.h>
 
 #include <cstdio> // For printf
-#include <set>
+#include <vector>
 
 #include <sst/core/activityQueue.h>
 
 namespace SST {
 
+class Event;
+
 /**
  * A link queue which is used for polling only.
+ *
+ * Events are kept in a ring buffer in delivery time order.  Events
+ * nearly always arrive in time order, so they are appended at the
+ * tail; an out of order arrival is moved into place, after any
+ * events with the same delivery time.
  */
 class PollingLinkQueue : public ActivityQueue {
 public:
@@ -34,10 +41,21 @@ public:
     void insert(Activity* activity);
     Activity* pop();
     Activity* front();
-    
+
+    /** Move every event with a delivery time no later than time to
+     * the end of events, in delivery order.
+     * @return number of events added */
+    size_t popReady(SimTime_t time, std::vector<Event*>& events);
     
 private:
-    std::multiset<Activity*,Activity::less_time> data;
+    /** Slot of the i'th entry from the head */
+    inline size_t slot(size_t i) const { return (head + i) & (data.size() - 1); }
+    void grow();
+
+    /** Ring storage, size is always a power of two */
+    std::vector<Activity*> data;
+    size_t head;
+    size_t count;
     
     friend class boost::serialization::access;
     template<class Archive>
@@ -48,6 +66,8 @@ private:
         ar & BOOST_SERIALIZATION_BASE_OBJECT_NVP(ActivityQueue);
         printf("  - PollingLinkQueue::data\n");
         ar & BOOST_SERIALIZATION_NVP(data);
+        ar & BOOST_SERIALIZATION_NVP(head);
+        ar & BOOST_SERIALIZATION_NVP(count);
         printf("end PollingLinkQueue::serialize\n");
     }
 };
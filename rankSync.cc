@@ -298,12 +298,8 @@ RankSync::recvEvents(comm_pair_recv& recv_info)
     }
     
     auto deserialStart = SST::Core::Profile::now();
-    boost::iostreams::basic_array_source<char> source(&buffer[sizeof(SyncQueue::Header)],size-sizeof(SyncQueue::Header));
-    boost::iostreams::stream<boost::iostreams::basic_array_source <char> > input_stream(source);
-    boost::archive::polymorphic_binary_iarchive ia(input_stream, boost::archive::no_header | boost::archive::no_tracking );
-    
     std::vector<Activity*>* activities = new std::vector<Activity*>();
-    ia >> *activities;
+    SyncQueue::extractActivities(buffer, *activities);
     deserializeTime += SST::Core::Profile::getElapsed(deserialStart);
     return activities;
     
@@ -392,12 +388,8 @@ RankSync::execute(void)
             buffer = i->second.rbuf;
         }
         
-        boost::iostreams::basic_array_source<char> source(&buffer[sizeof(SyncQueue::Header)],size-sizeof(SyncQueue::Header));
-        boost::iostreams::stream<boost::iostreams::basic_array_source <char> > input_stream(source);
-        boost::archive::polymorphic_binary_iarchive ia(input_stream, boost::archive::no_header | boost::archive::no_tracking );
-
         std::vector<Activity*> activities;
-        ia >> activities;
+        SyncQueue::extractActivities(buffer, activities);
 #endif
 
         std::vector<Activity*>* activities_ptr = recvEvents(i->second);
@@ -538,12 +530,8 @@ RankSync::exchangeLinkInitData(int msg_count)
             buffer = i->second.rbuf;
         }
         
-        boost::iostreams::basic_array_source<char> source(&buffer[sizeof(SyncQueue::Header)],size-sizeof(SyncQueue::Header));
-        boost::iostreams::stream<boost::iostreams::basic_array_source <char> > input_stream(source);
-        boost::archive::polymorphic_binary_iarchive ia(input_stream, boost::archive::no_header | boost::archive::no_tracking );
-        
         std::vector<Activity*> activities;
-        ia >> activities;
+        SyncQueue::extractActivities(buffer, activities);
 
         for ( unsigned int j = 0; j < activities.size(); j++ ) {
             
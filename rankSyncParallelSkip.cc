@@ -0,0 +1,264 @@
+// Copyright 2009-2015 Sandia Corporation. Under the terms
+// of Contract DE-AC04-94AL85000 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2015, Sandia Corporation
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include "sst_config.h"
+#include "sst/core/serialization.h"
+#include "sst/core/rankSyncParallelSkip.h"
+
+#include "sst/core/event.h"
+#include "sst/core/link.h"
+#include "sst/core/output.h"
+#include "sst/core/profile.h"
+#include "sst/core/simulation.h"
+#include "sst/core/syncQueue.h"
+#include "sst/core/timeConverter.h"
+
+namespace SST {
+
+RankSyncParallelSkip::RankSyncParallelSkip(Core::ThreadSafe::Barrier& barrier, TimeConverter* minPartTC) :
+    RankSyncSerialSkip(barrier, minPartTC),
+    parity(0),
+    serializeTime(0.0)
+{
+    num_threads = Simulation::getSimulation()->getNumRanks().thread;
+}
+
+RankSyncParallelSkip::~RankSyncParallelSkip()
+{
+    for ( size_t i = 0; i < peers.size(); i++ ) {
+        delete peers[i];
+    }
+    peers.clear();
+}
+
+ActivityQueue*
+RankSyncParallelSkip::registerLink(const RankInfo& to_rank, const RankInfo& from_rank, LinkId_t link_id, Link* link)
+{
+    // Events received for this link go to the thread of the Component
+    // on this rank
+    link_threads[link_id] = from_rank.thread;
+    return RankSyncSerialSkip::registerLink(to_rank, from_rank, link_id, link);
+}
+
+void
+RankSyncParallelSkip::finalizeLinkConfigurations()
+{
+    RankSyncSerialSkip::finalizeLinkConfigurations();
+
+    for ( comm_map_t::iterator i = comm_map.begin(); i != comm_map.end(); ++i ) {
+        Peer* peer = new Peer();
+        peer->rank = i->first;
+        peer->pair = &i->second;
+        for ( size_t j = 0; j < i->second.slots.size(); j++ ) {
+            Target target;
+            target.link = i->second.slots[j];
+            target.thread = link_threads[target.link->getId()];
+            peer->targets.push_back(target);
+        }
+        peer->send_buffer = NULL;
+        peer->ready.store(false, std::memory_order_relaxed);
+        peer->posted = false;
+#ifdef SST_CONFIG_HAVE_MPI
+        peer->sreq_count[0] = peer->sreq_count[1] = 0;
+#endif
+        peer->deliveries.resize(num_threads);
+        peers.push_back(peer);
+    }
+    link_threads.clear();
+
+#ifdef SST_CONFIG_HAVE_MPI
+    // The init data exchanges are complete, so the receives for the
+    // first sync can go up now
+    rreqs.resize(peers.size());
+    postReceives();
+#endif
+}
+
+void
+RankSyncParallelSkip::postReceives()
+{
+#ifdef SST_CONFIG_HAVE_MPI
+    for ( size_t i = 0; i < peers.size(); i++ ) {
+        comm_pair* pair = peers[i]->pair;
+        MPI_Irecv(pair->rbuf, pair->local_size, MPI_BYTE, peers[i]->rank, RUN_TAG, MPI_COMM_WORLD, &rreqs[i]);
+    }
+#endif
+}
+
+void
+RankSyncParallelSkip::sendReady(bool wait)
+{
+#ifdef SST_CONFIG_HAVE_MPI
+    size_t remaining;
+    do {
+        remaining = 0;
+        for ( size_t i = 0; i < peers.size(); i++ ) {
+            Peer* peer = peers[i];
+            if ( peer->posted ) continue;
+            if ( !peer->ready.load(std::memory_order_acquire) ) {
+                remaining++;
+                continue;
+            }
+
+            // Same protocol as RankSyncSerialSkip: if the remote buffer
+            // is too small, send the header alone first so it can grow
+            SyncQueue::Header* hdr = reinterpret_cast<SyncQueue::Header*>(peer->send_buffer);
+            MPI_Request* sreqs = peer->sreqs[parity];
+            int& count = peer->sreq_count[parity];
+            int tag = RUN_TAG;
+            if ( peer->pair->remote_size < hdr->buffer_size ) {
+                hdr->mode = 1;
+                MPI_Isend(peer->send_buffer, sizeof(SyncQueue::Header), MPI_BYTE,
+                          peer->rank, tag, MPI_COMM_WORLD, &sreqs[count++]);
+                peer->pair->remote_size = hdr->buffer_size;
+                tag = RUN_LARGE_TAG;
+            }
+            else {
+                hdr->mode = 0;
+            }
+            MPI_Isend(peer->send_buffer, hdr->buffer_size, MPI_BYTE,
+                      peer->rank, tag, MPI_COMM_WORLD, &sreqs[count++]);
+            peer->posted = true;
+        }
+        if ( remaining > 0 && wait ) _mm_pause();
+    } while ( remaining > 0 && wait );
+#endif
+}
+
+void
+RankSyncParallelSkip::decode(Peer* peer)
+{
+    std::vector<Activity*> activities;
+    SyncQueue::extractActivities(peer->pair->rbuf, activities);
+
+    for ( size_t j = 0; j < activities.size(); j++ ) {
+        Event* ev = static_cast<Event*>(activities[j]);
+        LinkId_t slot = ev->getLinkId();
+        if ( slot < 0 || (size_t)slot >= peer->targets.size() ) {
+            Simulation::getSimulation()->getSimulationOutput().fatal(CALL_INFO, 1, "Link slot %ld not found for rank %d!\n", slot, peer->rank);
+        }
+        const Target& target = peer->targets[slot];
+        Delivery delivery;
+        delivery.link = target.link;
+        delivery.ev = ev;
+        peer->deliveries[target.thread].push_back(delivery);
+    }
+}
+
+void
+RankSyncParallelSkip::execute(int thread)
+{
+#ifdef SST_CONFIG_HAVE_MPI
+    // SyncManager has already made sure every thread is done sending.
+    // Each thread serializes the queues of some of the peers, and
+    // thread 0 sends each buffer as soon as it is ready.
+    auto serialStart = SST::Core::Profile::now();
+    for ( size_t i = thread; i < peers.size(); i += num_threads ) {
+        peers[i]->send_buffer = peers[i]->pair->squeue->getData();
+        peers[i]->ready.store(true, std::memory_order_release);
+        if ( thread == 0 ) sendReady(false);
+    }
+
+    if ( thread == 0 ) {
+        sendReady(true);
+        serializeTime += SST::Core::Profile::getElapsed(serialStart);
+
+        auto waitStart = SST::Core::Profile::now();
+        MPI_Waitall(rreqs.size(), rreqs.data(), MPI_STATUSES_IGNORE);
+        for ( size_t i = 0; i < peers.size(); i++ ) {
+            comm_pair* pair = peers[i]->pair;
+            SyncQueue::Header* hdr = reinterpret_cast<SyncQueue::Header*>(pair->rbuf);
+            if ( hdr->mode == 1 ) {
+                uint32_t size = hdr->buffer_size;
+                if ( size > pair->local_size ) {
+                    delete[] pair->rbuf;
+                    pair->rbuf = new char[size];
+                    pair->local_size = size;
+                }
+                MPI_Recv(pair->rbuf, pair->local_size, MPI_BYTE,
+                         peers[i]->rank, RUN_LARGE_TAG, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+            }
+        }
+        mpiWaitTime += SST::Core::Profile::getElapsed(waitStart);
+    }
+    barrier.wait();
+
+    // Decode the buffers in parallel, sorting the events by the thread
+    // they are delivered on
+    auto deserialStart = SST::Core::Profile::now();
+    for ( size_t i = thread; i < peers.size(); i += num_threads ) {
+        decode(peers[i]);
+    }
+    if ( thread == 0 ) deserializeTime += SST::Core::Profile::getElapsed(deserialStart);
+    barrier.wait();
+
+    if ( thread == 0 ) {
+        // The receive buffers are free again.  The sends from the last
+        // sync completed long ago, since every peer has been through
+        // that sync; their buffers get reused by the next one.
+        postReceives();
+        for ( size_t i = 0; i < peers.size(); i++ ) {
+            Peer* peer = peers[i];
+            int last = parity ^ 1;
+            MPI_Waitall(peer->sreq_count[last], peer->sreqs[last], MPI_STATUSES_IGNORE);
+            peer->sreq_count[last] = 0;
+            peer->ready.store(false, std::memory_order_relaxed);
+            peer->posted = false;
+        }
+    }
+
+    // Each thread inserts the events for its own Links, in the order
+    // the serial sync would
+    SimTime_t current_cycle = Simulation::getSimulation()->getCurrentSimCycle();
+    for ( size_t i = 0; i < peers.size(); i++ ) {
+        std::vector<Delivery>& deliveries = peers[i]->deliveries[thread];
+        for ( size_t j = 0; j < deliveries.size(); j++ ) {
+            SimTime_t delay = deliveries[j].ev->getDeliveryTime() - current_cycle;
+            deliveries[j].link->send(delay, deliveries[j].ev);
+        }
+        deliveries.clear();
+    }
+    barrier.wait();
+
+    if ( thread == 0 ) {
+        GlobalReduction& reduction = SyncManager::getRankSyncReduction();
+        reduction.set(next_time_field, Simulation::getLocalMinimumNextActivityTime());
+        reduction.reduce();
+        myNextSyncTime = reduction.get(next_time_field) + max_period->getFactor();
+        parity ^= 1;
+    }
+#endif
+}
+
+void
+RankSyncParallelSkip::finish()
+{
+#ifdef SST_CONFIG_HAVE_MPI
+    // Nothing more will arrive, so take down the receives that were
+    // posted for the sync that will never happen
+    for ( size_t i = 0; i < rreqs.size(); i++ ) {
+        MPI_Cancel(&rreqs[i]);
+        MPI_Wait(&rreqs[i], MPI_STATUS_IGNORE);
+    }
+    rreqs.clear();
+    for ( size_t i = 0; i < peers.size(); i++ ) {
+        for ( int p = 0; p < 2; p++ ) {
+            MPI_Waitall(peers[i]->sreq_count[p], peers[i]->sreqs[p], MPI_STATUSES_IGNORE);
+            peers[i]->sreq_count[p] = 0;
+        }
+    }
+#endif
+    if ( mpiWaitTime > 0.0 || deserializeTime > 0.0 || serializeTime > 0.0 )
+        Output::getDefaultObject().verbose(CALL_INFO, 1, 0, "RankSyncParallelSkip mpiWait: %lg sec  serialize: %lg sec  deserialize: %lg sec\n",
+                                           mpiWaitTime, serializeTime, deserializeTime);
+}
+
+} // namespace SST
@@ -0,0 +1,107 @@
+// Copyright 2009-2015 Sandia Corporation. Under the terms
+// of Contract DE-AC04-94AL85000 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2015, Sandia Corporation
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef SST_CORE_RANKSYNCPARALLELSKIP_H
+#define SST_CORE_RANKSYNCPARALLELSKIP_H
+
+#include "sst/core/sst_types.h"
+#include <sst/core/rankSyncSerialSkip.h>
+
+#include <atomic>
+#include <vector>
+
+#ifdef SST_CONFIG_HAVE_MPI
+#include <mpi.h>
+#endif
+
+namespace SST {
+
+class Event;
+
+/** RankSync that spreads the work of a rank sync over all the threads
+ * of the rank.  Each thread serializes the queues for some of the
+ * destination ranks, and thread 0 sends each buffer as soon as it is
+ * ready.  Receives for the next sync are posted as soon as the last
+ * ones have been decoded, and each thread delivers the events for its
+ * own links.  SyncQueue double buffering means the sends from one sync
+ * never have to be waited on before the next one starts.
+ *
+ * Only thread 0 makes MPI calls, so MPI does not need to support
+ * threads.
+ */
+class RankSyncParallelSkip : public RankSyncSerialSkip {
+public:
+    RankSyncParallelSkip(Core::ThreadSafe::Barrier& barrier, TimeConverter* minPartTC);
+    virtual ~RankSyncParallelSkip();
+
+    /** Register a Link which this Sync Object is responsible for */
+    ActivityQueue* registerLink(const RankInfo& to_rank, const RankInfo& from_rank, LinkId_t link_id, Link* link);
+    void execute(int thread);
+
+    /** Finish link configuration */
+    void finalizeLinkConfigurations();
+    /** Complete outstanding communication at the end of the run */
+    void finish();
+
+private:
+    /** Tags used while running, so that receives can be posted before
+     * the init data exchange is known to be over on the other side */
+    static const int RUN_TAG = 3;
+    static const int RUN_LARGE_TAG = 4;
+
+    struct Target {
+        Link* link;
+        uint32_t thread;
+    };
+
+    struct Delivery {
+        Link* link;
+        Event* ev;
+    };
+
+    struct Peer {
+        int rank;
+        comm_pair* pair;
+        char* send_buffer;
+        std::atomic<bool> ready;
+        bool posted;
+#ifdef SST_CONFIG_HAVE_MPI
+        /** Sends of the last sync, for each of the two buffers */
+        MPI_Request sreqs[2][2];
+        int sreq_count[2];
+#endif
+        /** Where the events for each slot are delivered */
+        std::vector<Target> targets;
+        /** Received events for each thread, in the order sent */
+        std::vector<std::vector<Delivery> > deliveries;
+    };
+
+    uint32_t num_threads;
+    /** Which of the two SyncQueue buffers this sync is using */
+    int parity;
+    std::vector<Peer*> peers;
+    /** Thread on this rank each link delivers to, until the targets
+     * are built */
+    std::map<LinkId_t, uint32_t> link_threads;
+#ifdef SST_CONFIG_HAVE_MPI
+    std::vector<MPI_Request> rreqs;
+#endif
+    double serializeTime;
+
+    void postReceives();
+    void sendReady(bool wait);
+    void decode(Peer* peer);
+};
+
+
+} // namespace SST
+
+#endif // SST_CORE_RANKSYNCPARALLELSKIP_H
@@ -23,6 +23,8 @@
 #include "sst/core/timeConverter.h"
 #include "sst/core/profile.h"
 
+#include <algorithm>
+
 #include <boost/archive/polymorphic_binary_iarchive.hpp>
 #include <boost/iostreams/stream_buffer.hpp>
 #include <boost/iostreams/stream.hpp>
@@ -166,6 +168,7 @@ RankSyncSerialSkip::RankSyncSerialSkip(Core::ThreadSafe::Barrier& barrier, TimeC
 {
     max_period = Simulation::getSimulation()->getMinPartTC();
     myNextSyncTime = max_period->getFactor();
+    next_time_field = SyncManager::getRankSyncReduction().addField(GlobalReduction::MIN);
 }
 
 RankSyncSerialSkip::~RankSyncSerialSkip()
@@ -198,6 +201,7 @@ ActivityQueue* RankSyncSerialSkip::registerLink(const RankInfo& to_rank, const R
     }
 	
     link_map[link_id] = link;
+    comm_map[to_rank.rank].slots.push_back(link);
 #ifdef __SST_DEBUG_EVENT_TRACKING__
     link->setSendingComponentInfo("SYNC", "SYNC", "");
 #endif
@@ -212,6 +216,16 @@ RankSyncSerialSkip::finalizeLinkConfigurations() {
         // i->second->finalizeConfiguration();
         finalizeConfiguration(i->second);
     }
+
+    // Both ranks number the links they share in link id order, so a
+    // received event's slot indexes straight into the same list here
+    for (comm_map_t::iterator i = comm_map.begin() ; i != comm_map.end() ; ++i) {
+        std::vector<Link*>& slots = i->second.slots;
+        std::sort(slots.begin(), slots.end(), [](Link* a, Link* b) { return a->getId() < b->getId(); });
+        for ( size_t j = 0; j < slots.size(); j++ ) {
+            setSyncSlot(slots[j], j);
+        }
+    }
 }
 
 uint64_t
@@ -320,24 +334,21 @@ RankSyncSerialSkip::exchange(void)
         }
         
         auto deserialStart = SST::Core::Profile::now();
-        boost::iostreams::basic_array_source<char> source(&buffer[sizeof(SyncQueue::Header)],size-sizeof(SyncQueue::Header));
-        boost::iostreams::stream<boost::iostreams::basic_array_source <char> > input_stream(source);
-        boost::archive::polymorphic_binary_iarchive ia(input_stream, boost::archive::no_header | boost::archive::no_tracking );
-        deserializeTime += SST::Core::Profile::getElapsed(deserialStart);
-
         std::vector<Activity*> activities;
-        ia >> activities;
+        SyncQueue::extractActivities(buffer, activities);
+        deserializeTime += SST::Core::Profile::getElapsed(deserialStart);
+        std::vector<Link*>& slots = i->second.slots;
         for ( unsigned int j = 0; j < activities.size(); j++ ) {
             
             Event* ev = static_cast<Event*>(activities[j]);
-            link_map_t::iterator link = link_map.find(ev->getLinkId());
-            if (link == link_map.end()) {
-                printf("Link not found in map!\n");
+            LinkId_t slot = ev->getLinkId();
+            if ( slot < 0 || (size_t)slot >= slots.size() ) {
+                printf("Link slot %ld not found for rank %d!\n", slot, i->first);
                 abort();
             } else {
                 // Need to figure out what the "delay" is for this event.
                 SimTime_t delay = ev->getDeliveryTime() - current_cycle;
-                link->second->send(delay,ev);
+                slots[slot]->send(delay,ev);
             }
         }
         
@@ -375,9 +386,12 @@ RankSyncSerialSkip::exchange(void)
 
     // Need to get the local minimum, then do a global minimum
     // SimTime_t input = Simulation::getSimulation()->getNextActivityTime();
-    SimTime_t input = Simulation::getLocalMinimumNextActivityTime();
-    SimTime_t min_time;
-    MPI_Allreduce( &input, &min_time, 1, MPI_UINT64_T, MPI_MIN, MPI_COMM_WORLD );
+    // The same collective carries everything else registered with the
+    // rank sync reduction, such as the Exit state
+    GlobalReduction& reduction = SyncManager::getRankSyncReduction();
+    reduction.set(next_time_field, Simulation::getLocalMinimumNextActivityTime());
+    reduction.reduce();
+    SimTime_t min_time = reduction.get(next_time_field);
 
     myNextSyncTime = min_time + max_period->getFactor();
     
@@ -459,12 +473,8 @@ RankSyncSerialSkip::exchangeLinkInitData(int thread, std::atomic<int>& msg_count
             buffer = i->second.rbuf;
         }
         
-        boost::iostreams::basic_array_source<char> source(&buffer[sizeof(SyncQueue::Header)],size-sizeof(SyncQueue::Header));
-        boost::iostreams::stream<boost::iostreams::basic_array_source <char> > input_stream(source);
-        boost::archive::polymorphic_binary_iarchive ia(input_stream, boost::archive::no_header | boost::archive::no_tracking );
-        
         std::vector<Activity*> activities;
-        ia >> activities;
+        SyncQueue::extractActivities(buffer, activities);
         for ( unsigned int j = 0; j < activities.size(); j++ ) {
             
             Event* ev = static_cast<Event*>(activities[j]);
@@ -17,6 +17,7 @@
 #include <sst/core/threadsafe.h>
 
 #include <map>
+#include <vector>
 
 namespace SST {
 
@@ -43,10 +44,12 @@ public:
     
     uint64_t getDataSize() const;
     
-private:
+protected:
 
     static SimTime_t myNextSyncTime;
     TimeConverter* minPartTC;
+    /** Minimum next activity time, in the rank sync reduction */
+    GlobalReduction::field_t next_time_field;
     
     // Function that actually does the exchange during run
     void exchange();
@@ -56,6 +59,9 @@ private:
         char* rbuf; // receive buffer
         uint32_t local_size;
         uint32_t remote_size;
+        /** Links shared with the remote rank, indexed by the slot their
+         * events carry on the wire */
+        std::vector<Link*> slots;
     };
     
     // typedef std::map<int, std::pair<SyncQueueC*, std::vector<char>* > > comm_map_t;
@@ -71,6 +77,7 @@ private:
 
     Core::ThreadSafe::Barrier& barrier;
 
+private:
     friend class boost::serialization::access;
     template<class Archive>
     void serialize(Archive & ar, const unsigned int version);
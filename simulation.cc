@@ -14,6 +14,8 @@
 #include "sst/core/serialization.h"
 #include <sst/core/simulation.h>
 
+#include <algorithm>
+#include <unordered_set>
 #include <utility>
 
 #include <boost/foreach.hpp>
@@ -23,7 +25,7 @@
 #include <sst/core/config.h>
 #include <sst/core/configGraph.h>
 #include <sst/core/heartbeat.h>
-//#include <sst/core/event.h>
+#include <sst/core/event.h>
 #include <sst/core/exit.h>
 #include <sst/core/factory.h>
 //#include <sst/core/graph.h>
@@ -37,10 +39,13 @@
 #include <sst/core/rankSync.h>
 #include <sst/core/sync.h>
 #include <sst/core/syncManager.h>
+#include <sst/core/statapi/statengine.h>
+#include <sst/core/statapi/statlinktraffic.h>
 #include <sst/core/syncQueue.h>
 #include <sst/core/threadSync.h>
 #include <sst/core/timeLord.h>
 #include <sst/core/timeVortex.h>
+#include <sst/core/clockRing.h>
 #include <sst/core/unitAlgebra.h>
 
 #define SST_SIMTIME_MAX  0xffffffffffffffff
@@ -72,10 +77,16 @@ Simulation::~Simulation()
 
     // Delete the Statistic Objects
     delete statisticsEngine;
+    for ( auto && stat : linkTrafficStats ) {
+        delete stat;
+    }
+    linkTrafficStats.clear();
 
     // Delete the timeVortex first.  This will delete all events left
-    // in the queue, as well as the Sync, Exit and Clock objects.
+    // in the queue, as well as the Sync and Exit objects.  The
+    // scheduled Clock objects are deleted with the clockRing.
     delete timeVortex;
+    delete clockRing;
 
     if ( sync && (my_rank.thread == 0) ) delete sync;
 
@@ -91,7 +102,7 @@ Simulation::~Simulation()
     }
     introMap.clear();
 
-    // Clocks already got deleted by timeVortex, simply clear the clockMap
+    // Clocks already got deleted by clockRing, simply clear the clockMap
     clockMap.clear();
     
     // OneShots already got deleted by timeVortex, simply clear the onsShotMap
@@ -125,6 +136,7 @@ Simulation::createSimulation(Config *config, RankInfo my_rank, RankInfo num_rank
 
     std::lock_guard<std::mutex> lock(simulationMutex);
     instanceMap[tid] = instance;
+    Simulation::instance = instance;
     instanceVec.resize(num_ranks.thread);
     instanceVec[my_rank.thread] = instance;
     return instance;
@@ -134,6 +146,7 @@ Simulation::createSimulation(Config *config, RankInfo my_rank, RankInfo num_rank
 void Simulation::shutdown()
 {
     instanceMap.clear();
+    instance = NULL;
 }
 
 
@@ -141,6 +154,13 @@ void Simulation::shutdown()
 Simulation::Simulation( Config* cfg, RankInfo my_rank, RankInfo num_ranks) :
     runMode(cfg->runMode),
     timeVortex(NULL),
+    clockRing(NULL),
+    dispatch_count(0),
+    dispatch_next(0),
+    threadSyncType(cfg->thread_sync),
+    rankSyncType(cfg->rank_sync),
+    threadBalanceThreshold(cfg->thread_balance_threshold),
+    threadBalancePeriod(0),
     threadSync(NULL),
     currentSimCycle(0),
     endSimCycle(0),
@@ -151,15 +171,23 @@ Simulation::Simulation( Config* cfg, RankInfo my_rank, RankInfo num_ranks) :
     init_phase(0),
     lastRecvdSignal(0),
     shutdown_mode(SHUTDOWN_CLEAN),
-    wireUpFinished(false)
+    wireUpFinished(false),
+    linkStatistics(cfg->link_stats)
 {
+    // Simulations are created by the thread that runs them
+    barrierStats = &Core::ThreadSafe::Barrier::getThreadWaitStats();
+
     sim_output.init(cfg->output_core_prefix, cfg->getVerboseLevel(), 0, Output::STDOUT);
     output_directory = "";
 
     // Create the Statistic Processing Engine
     statisticsEngine = new StatisticProcessingEngine();
 
-    timeVortex = new TimeVortex;
+    timeVortex = TimeVortex::getTimeVortex(cfg->timeVortex);
+    if ( timeVortex == NULL ) {
+        sim_output.fatal(CALL_INFO, 1, "Unknown TimeVortex implementation: %s\n", cfg->timeVortex.c_str());
+    }
+    clockRing = new ClockRing(timeVortex);
     if( my_rank.thread == 0 ) {
         m_exit = new Exit( num_ranks.thread, timeLord.getTimeConverter("100ns"), num_ranks.rank == 1 );
     }
@@ -169,6 +197,13 @@ Simulation::Simulation( Config* cfg, RankInfo my_rank, RankInfo num_ranks) :
     	m_heartbeat = new SimulatorHeartbeat(cfg, my_rank.rank, this, timeLord.getTimeConverter(cfg->heartbeatPeriod) );
     }
 
+    if ( threadBalanceThreshold > 0.0 ) {
+        threadBalancePeriod = timeLord.getSimCycles(cfg->thread_balance_period, "thread balance period");
+        if ( threadBalancePeriod == 0 ) {
+            sim_output.fatal(CALL_INFO, 1, "thread-balance-period must be greater than zero\n");
+        }
+    }
+
     // Need to create the thread sync if there is more than one thread
     if ( num_ranks.thread > 1 ) {
         threadSync = new ThreadSync(num_ranks.thread, this);
@@ -214,7 +249,14 @@ Simulation::requireEvent(std::string name)
 SimTime_t
 Simulation::getNextActivityTime() const
 {
-    return timeVortex->front()->getDeliveryTime();
+    // Activities still waiting in the dispatch batch are due before
+    // anything left in the TimeVortex
+    if ( dispatch_next < dispatch_count ) return dispatch_batch[dispatch_next]->getDeliveryTime();
+    SimTime_t next = timeVortex->front()->getDeliveryTime();
+    if ( !clockRing->empty() && clockRing->front()->getDeliveryTime() < next ) {
+        next = clockRing->front()->getDeliveryTime();
+    }
+    return next;
 }
 
 SimTime_t
@@ -231,6 +273,23 @@ Simulation::getLocalMinimumNextActivityTime()
     return ret;
 }
 
+SimTime_t
+Simulation::getLocalMinimumInterThreadDeliveryTime()
+{
+    SimTime_t ret = MAX_SIMTIME_T;
+    for ( auto && instance : instanceVec ) {
+        SimTime_t latency = instance->interThreadSendLatency;
+        if ( latency == MAX_SIMTIME_T ) continue;
+        SimTime_t next = instance->getNextActivityTime();
+        if ( next >= MAX_SIMTIME_T - latency ) continue;
+        if ( next + latency < ret ) {
+            ret = next + latency;
+        }
+    }
+
+    return ret;
+}
+
 void
 Simulation::processGraphInfo( ConfigGraph& graph, const RankInfo& myRank, SimTime_t min_part )
 {
@@ -239,12 +298,11 @@ Simulation::processGraphInfo( ConfigGraph& graph, const RankInfo& myRank, SimTim
         minPartTC = minPartToTC(min_part);
     }
 
-    // Get the minimum latencies for links between the various threads
-    
-    interThreadLatencies.resize(num_ranks.thread);
-    for ( int i = 0; i < interThreadLatencies.size(); i++ ) {
-        interThreadLatencies[i] = MAX_SIMTIME_T;
-    }
+    // Get the minimum latencies for links between the various
+    // threads.  Every thread builds the whole matrix, in each
+    // direction, so the syncs can use the latencies of the other
+    // threads' links as well as their own.
+    interThreadLatencyMatrix.assign(num_ranks.thread, std::vector<SimTime_t>(num_ranks.thread, MAX_SIMTIME_T));
 
     if ( num_ranks.thread > 1 ) {
         // Need to determine the lookahead for the thread synchronization
@@ -260,26 +318,52 @@ Simulation::processGraphInfo( ConfigGraph& graph, const RankInfo& myRank, SimTim
             // different threads
             if ( rank[0] == rank[1] ) continue;
             if ( rank[0].rank != rank[1].rank ) continue;
-            // Keep track of minimum latency for each other thread
-            // separately
-            if ( rank[0].thread == my_rank.thread) { 
-                if ( clink.getMinLatency() < interThreadLatencies[rank[1].thread] ) {
-                    interThreadLatencies[rank[1].thread] = clink.getMinLatency();
-                }
-            }
-            else if ( rank[1].thread == my_rank.thread ) {
-                if ( clink.getMinLatency() < interThreadLatencies[rank[0].thread] ) {
-                    interThreadLatencies[rank[0].thread] = clink.getMinLatency();
-                }
+            // latency[i] is added to events sent from component[i]
+            for ( int i = 0; i < 2; i++ ) {
+                SimTime_t& entry = interThreadLatencyMatrix[rank[i].thread][rank[1-i].thread];
+                if ( clink.latency[i] < entry ) entry = clink.latency[i];
             }
         }
     }
+    computeInterThreadLatencies();
+
     // Create the SyncManager for this rank.  It gets created even if
     // we are single rank/single thread because it also manages the
     // Exit and Heartbeat actions.
-    syncManager = new SyncManager(my_rank, num_ranks, barrier, minPartTC = minPartToTC(min_part), interThreadLatencies);
+    syncManager = new SyncManager(my_rank, num_ranks, barrier, minPartTC = minPartToTC(min_part), interThreadLatencies, threadSyncType, rankSyncType);
+    syncManager->setLoadBalanceCheck(threadBalanceThreshold, threadBalancePeriod);
 }
     
+void
+Simulation::computeInterThreadLatencies()
+{
+    minInterThreadLatency = MAX_SIMTIME_T;
+    for ( uint32_t i = 0; i < num_ranks.thread; i++ ) {
+        for ( uint32_t j = 0; j < num_ranks.thread; j++ ) {
+            if ( interThreadLatencyMatrix[i][j] < minInterThreadLatency ) {
+                minInterThreadLatency = interThreadLatencyMatrix[i][j];
+            }
+        }
+    }
+
+    // Keep track of minimum latency for each other thread, in either
+    // direction
+    interThreadLatencies.resize(num_ranks.thread);
+    for ( size_t i = 0; i < interThreadLatencies.size(); i++ ) {
+        SimTime_t to = interThreadLatencyMatrix[my_rank.thread][i];
+        SimTime_t from = interThreadLatencyMatrix[i][my_rank.thread];
+        interThreadLatencies[i] = to < from ? to : from;
+    }
+
+    // Smallest latency of a link leaving this thread
+    interThreadSendLatency = MAX_SIMTIME_T;
+    for ( uint32_t i = 0; i < num_ranks.thread; i++ ) {
+        if ( interThreadLatencyMatrix[my_rank.thread][i] < interThreadSendLatency ) {
+            interThreadSendLatency = interThreadLatencyMatrix[my_rank.thread][i];
+        }
+    }
+}
+
 int Simulation::performWireUp( ConfigGraph& graph, const RankInfo& myRank, SimTime_t min_part )
 {
     // TraceFunction trace(CALL_INFO_LONG);    
@@ -575,6 +659,8 @@ int Simulation::performWireUp( ConfigGraph& graph, const RankInfo& myRank, SimTi
     statisticEnableMap.clear();
     statisticParamsMap.clear();
     */
+    if ( linkStatistics ) createLinkTrafficStatistics(graph, myRank);
+
     wireUpFinished = true;
     // std::cout << "Done with performWireUp" << std::endl;
     return 0;
@@ -676,10 +762,57 @@ void Simulation::run() {
     header += SST::to_string(my_rank.thread);
     header += ":  ";
     // wait_my_turn_end(barrier, my_rank.thread, num_ranks.thread);
+    // Activities are pulled from the TimeVortex in batches that share
+    // a delivery time and priority.  Anything inserted while a batch
+    // is executing that sorts ahead of the rest of the batch (i.e. the
+    // same time with a lower priority) is run first, so the execution
+    // order is identical to popping one Activity at a time.  Clocks
+    // are kept in the clockRing and merged in by the same comparison.
+    // The clockRing front is compared on every step since a Clock can
+    // share the batch's time and priority with a queue order that
+    // falls between two batch entries.
+    Activity::pq_less_time_priority later;
+    uint64_t checked_inserts = 0;
     while( LIKELY( ! endSim ) ) {
-        currentSimCycle = timeVortex->front()->getDeliveryTime();
-        currentPriority = timeVortex->front()->getPriority();
-        current_activity = timeVortex->pop();
+        if ( dispatch_next == dispatch_count ) {
+            if ( !clockRing->empty() && later(timeVortex->front(), clockRing->front()) ) {
+                current_activity = clockRing->pop();
+            }
+            else {
+                dispatch_count = timeVortex->popBatch(dispatch_batch, DISPATCH_BATCH_SIZE);
+                dispatch_next = 0;
+                checked_inserts = timeVortex->getInsertCount();
+                for ( unsigned int i = 1; i < dispatch_count; i++ ) {
+                    __builtin_prefetch(dispatch_batch[i]);
+                }
+                current_activity = dispatch_batch[dispatch_next++];
+            }
+        }
+        else {
+            ActivityQueue* source = NULL;
+            Activity* next = dispatch_batch[dispatch_next];
+            if ( timeVortex->getInsertCount() != checked_inserts ) {
+                Activity* inserted = timeVortex->front();
+                if ( later(next, inserted) ) {
+                    source = timeVortex;
+                    next = inserted;
+                }
+                // Only stop checking once the TimeVortex front sorts
+                // after the whole batch.  Delay lines insert events
+                // with queue orders reserved earlier, which can fall
+                // between the orders of the remaining batch entries.
+                else if ( later(inserted, dispatch_batch[dispatch_count - 1]) ) {
+                    checked_inserts = timeVortex->getInsertCount();
+                }
+            }
+            if ( !clockRing->empty() && later(next, clockRing->front()) ) {
+                source = clockRing;
+            }
+            if ( source != NULL ) current_activity = source->pop();
+            else current_activity = dispatch_batch[dispatch_next++];
+        }
+        currentSimCycle = current_activity->getDeliveryTime();
+        currentPriority = current_activity->getPriority();
         // current_activity->print(header, sim_output);
         current_activity->execute();
 
@@ -703,6 +836,12 @@ void Simulation::run() {
             lastRecvdSignal = 0;
         }
     }
+    // Return anything left in the dispatch batch to the TimeVortex so
+    // it gets cleaned up with everything else
+    while ( dispatch_next < dispatch_count ) {
+        timeVortex->insert(dispatch_batch[dispatch_next++]);
+    }
+
     /* We shouldn't need to do this, but to be safe... */
     ThreadSync::disable();
 
@@ -714,6 +853,49 @@ void Simulation::run() {
 
     // Tell the Statistics Engine that the simulation is ending
     statisticsEngine->endOfSimulation();
+    if ( linkStatistics ) outputLinkTrafficStatistics();
+}
+
+void Simulation::createLinkTrafficStatistics( ConfigGraph& graph, const RankInfo &myRank )
+{
+    // Each side of a link counts what its own component sends, keyed
+    // by the ConfigLink name
+    std::string statName = "link_traffic";
+    Params statParams;
+    for ( ConfigLinkMap_t::iterator iter = graph.links.begin();
+            iter != graph.links.end(); ++iter )
+    {
+        ConfigLink &clink = *iter;
+        for ( int i = 0; i < 2; i++ ) {
+            if ( graph.comps[clink.component[i]].rank != myRank ) continue;
+            ComponentInfo* cinfo = compInfoMap.getByID(clink.component[i]);
+            if ( cinfo == NULL || cinfo->getComponent() == NULL ) continue;
+            Link* link = cinfo->getLinkMap()->getLink(clink.port[i]);
+            if ( link == NULL ) continue;
+
+            LinkTrafficStatistic* stat =
+                new LinkTrafficStatistic(cinfo->getComponent(), statName, clink.name, statParams);
+            statisticsOutput->lock();
+            statisticsOutput->startRegisterFields(stat->getCompName().c_str(), stat->getStatName().c_str());
+            stat->registerOutputFields(statisticsOutput);
+            statisticsOutput->stopRegisterFields();
+            statisticsOutput->unlock();
+
+            link->traffic = stat;
+            linkTrafficStats.push_back(stat);
+        }
+    }
+}
+
+void Simulation::outputLinkTrafficStatistics()
+{
+    for ( auto && stat : linkTrafficStats ) {
+        statisticsOutput->lock();
+        statisticsOutput->startOutputEntries(stat);
+        stat->outputStatisticData(statisticsOutput, true);
+        statisticsOutput->stopOutputEntries();
+        statisticsOutput->unlock();
+    }
 }
 
 
@@ -746,6 +928,9 @@ void Simulation::endSimulation(SimTime_t end)
     endSimCycle = end;
     endSim = true;
 
+    // Don't leave other threads waiting on this one in the ThreadSync
+    syncManager->stopSending();
+
     exit_barrier.wait();
 
 
@@ -754,6 +939,8 @@ void Simulation::endSimulation(SimTime_t end)
 
 void Simulation::finish() {
 
+    syncManager->finish();
+
     for ( auto iter = compInfoMap.begin(); iter != compInfoMap.end(); ++iter )
     {
         (*iter)->getComponent()->finish();
@@ -839,6 +1026,7 @@ void Simulation::printStatus(bool fullStatus)
 
     if ( fullStatus ) {
         timeVortex->print(out);
+        clockRing->print(out);
         out.output("---- Components: ----\n");
         for ( auto iter = compInfoMap.begin(); iter != compInfoMap.end(); ++iter ) {
             (*iter)->getComponent()->printStatus(out);
@@ -939,6 +1127,124 @@ void Simulation::insertActivity(SimTime_t time, Activity* ev) {
 
 }
 
+void Simulation::insertClock(SimTime_t time, Clock* clock) {
+    clock->setDeliveryTime(time);
+    clockRing->insert(clock);
+}
+
+bool Simulation::hasUnownedHandlers() const {
+    for ( clockMap_t::const_iterator it = clockMap.begin(); it != clockMap.end(); ++it ) {
+        if ( it->second->hasUnownedHandlers() ) return true;
+    }
+    for ( oneShotMap_t::const_iterator it = oneShotMap.begin(); it != oneShotMap.end(); ++it ) {
+        if ( it->second->hasUnownedHandlers() ) return true;
+    }
+    return false;
+}
+
+void Simulation::exportComponent(ComponentMigration& migration) {
+    Component* comp = migration.info->getComponent();
+
+    // Clock handlers registered through the Component.  The suspended
+    // ones are kept by the Component and go with it.
+    for ( clockMap_t::iterator it = clockMap.begin(); it != clockMap.end(); ++it ) {
+        std::vector<Clock::HandlerBase*> removed;
+        it->second->removeHandlers(&comp->suspendedClocks, removed);
+        for ( size_t i = 0; i < removed.size(); i++ ) {
+            migration.clocks.push_back(std::make_pair(it->second->getPeriod(), removed[i]));
+        }
+    }
+
+    for ( oneShotMap_t::iterator it = oneShotMap.begin(); it != oneShotMap.end(); ++it ) {
+        std::vector<std::pair<SimTime_t, OneShot::HandlerBase*> > removed;
+        it->second->removeHandlers(comp, removed);
+        for ( size_t i = 0; i < removed.size(); i++ ) {
+            ComponentMigration::PendingOneShot pending = { it->first, removed[i].first, removed[i].second };
+            migration.oneshots.push_back(pending);
+        }
+    }
+
+    // Events for handler links are in the TimeVortex, or held by the
+    // link's delay line.  Polling links keep theirs in a queue that
+    // goes with the Link.
+    std::unordered_set<Link*> links;
+    std::map<std::string,Link*>& link_map = migration.info->getLinkMap()->getLinkMap();
+    for ( std::map<std::string,Link*>::iterator it = link_map.begin(); it != link_map.end(); ++it ) {
+        Link* link = it->second;
+        if ( link->delay_line == NULL ) continue;
+        links.insert(link);
+        migration.tv_links.push_back(link);
+    }
+    if ( !links.empty() ) {
+        auto select = [&links](Activity* activity) -> bool {
+            Event* ev = dynamic_cast<Event*>(activity);
+            return ev != NULL && links.count(ev->getDeliveryLink()) != 0;
+        };
+
+        // The rest of the batch being run also sorts ahead of
+        // everything in the TimeVortex
+        unsigned int kept = dispatch_next;
+        for ( unsigned int i = dispatch_next; i < dispatch_count; i++ ) {
+            if ( select(dispatch_batch[i]) ) migration.events.push_back(dispatch_batch[i]);
+            else dispatch_batch[kept++] = dispatch_batch[i];
+        }
+        dispatch_count = kept;
+
+        timeVortex->extract(select, migration.events);
+        for ( size_t i = 0; i < migration.tv_links.size(); i++ ) {
+            Link* link = migration.tv_links[i];
+            link->delay_line->release(migration.events);
+            delete link->delay_line;
+            link->delay_line = NULL;
+        }
+    }
+
+    statisticsEngine->removeComponentStatistics(migration);
+    compInfoMap.erase(migration.info);
+}
+
+void Simulation::importComponent(ComponentMigration& migration) {
+    Component* comp = migration.info->getComponent();
+    comp->sim = this;
+    compInfoMap.insert(migration.info);
+
+    // Clocks are found by period, the same way registerClock() does
+    auto get_clock = [this](TimeConverter* period) -> Clock* {
+        Clock*& clock = clockMap[period->getFactor()];
+        if ( clock == NULL ) clock = new Clock(period);
+        return clock;
+    };
+    for ( size_t i = 0; i < migration.clocks.size(); i++ ) {
+        get_clock(migration.clocks[i].first)->registerHandler(migration.clocks[i].second);
+    }
+    comp->suspendedClocks.moveClocks(get_clock);
+
+    for ( size_t i = 0; i < migration.oneshots.size(); i++ ) {
+        ComponentMigration::PendingOneShot& pending = migration.oneshots[i];
+        OneShot*& oneshot = oneShotMap[pending.delay];
+        if ( oneshot == NULL ) oneshot = new OneShot(minPartToTC(pending.delay));
+        oneshot->registerHandlerAt(pending.time, pending.handler);
+    }
+
+    for ( size_t i = 0; i < migration.tv_links.size(); i++ ) {
+        Link* link = migration.tv_links[i];
+        link->delay_line = new LinkDelayLine(timeVortex);
+        link->recvQueue = link->delay_line;
+    }
+    // Put the events in the order they had on the other thread.  They
+    // bypass the new delay lines, which are empty until the next send.
+    // insertBatch() gives them queue orders after the events already
+    // here, so ties on time and priority with this thread's events
+    // now go to those events.  Since moves are triggered by wall
+    // clock time, this order can differ from run to run.
+    Activity::pq_less_time_priority later;
+    std::sort(migration.events.begin(), migration.events.end(),
+              [&later](Activity* lhs, Activity* rhs) { return later(rhs, lhs); });
+    timeVortex->insertBatch(migration.events.data(), migration.events.size());
+
+    statisticsEngine->addComponentStatistics(migration);
+}
+
 uint64_t Simulation::getTimeVortexMaxDepth() const {
     return timeVortex->getMaxDepth();
 }
@@ -952,6 +1258,26 @@ uint64_t Simulation::getSyncQueueDataSize() const {
     return sync->getDataSize();
 }
 
+double Simulation::getThreadBusyTime() const {
+    return syncManager->getBusyTime();
+}
+
+void Simulation::getThreadBalanceChecks(uint64_t& checks, uint64_t& imbalanced, uint64_t& moved) const {
+    syncManager->getLoadBalanceChecks(checks, imbalanced, moved);
+}
+
+void Simulation::getBarrierWaitStats(uint64_t& waits, double& total_time, double& max_time) {
+    waits = 0;
+    total_time = 0.0;
+    max_time = 0.0;
+    for ( auto && instance : instanceVec ) {
+        waits += instance->barrierStats->count.load(std::memory_order_relaxed);
+        double time = instance->barrierStats->nanoseconds.load(std::memory_order_relaxed) * 1e-9;
+        total_time += time;
+        if ( time > max_time ) max_time = time;
+    }
+}
+
     
 template<class Archive>
 void
@@ -963,6 +1289,8 @@ Simulation::serialize(Archive & ar, const unsigned int version)
 
     printf("  - Simulation::timeVortex\n");
     ar & BOOST_SERIALIZATION_NVP(timeVortex);
+    printf("  - Simulation::clockRing\n");
+    ar & BOOST_SERIALIZATION_NVP(clockRing);
 
     printf("  - Simulation::sync (%p)\n", sync);
     ar & BOOST_SERIALIZATION_NVP(sync);
@@ -1051,6 +1379,7 @@ SyncBase* Simulation::sync = NULL;
 SharedRegionManager* Simulation::sharedRegionManager = new SharedRegionManagerImpl();
 std::unordered_map<std::thread::id, Simulation*> Simulation::instanceMap;
 std::vector<Simulation*> Simulation::instanceVec;
+thread_local Simulation* Simulation::instance = NULL;
 std::atomic<int> Simulation::init_msg_count;
 Exit* Simulation::m_exit;
 
@@ -50,6 +50,7 @@ class Factory;
 class SimulatorHeartbeat;
 //class Graph;
 class Introspector;
+class Link;
 class LinkMap;
 class Params;
 class SyncBase;
@@ -57,10 +58,13 @@ class SyncManager;
 class ThreadSync;
 class TimeConverter;
 class TimeLord;
+class ClockRing;
 class TimeVortex;
 class UnitAlgebra;
 class SharedRegionManager;
 namespace Statistics {
+    class LinkTrafficStatistic;
+    class StatisticBase;
     class StatisticOutput;
     class StatisticProcessingEngine;
 }
@@ -68,6 +72,50 @@ namespace Statistics {
 
 typedef std::map<std::string, Introspector* > IntroMap_t;
 
+/**
+ * A Component moving from one thread of a rank to another.  The
+ * thread it leaves takes its handlers, in flight events and
+ * statistics off its own queues and records them here, and the thread
+ * it goes to puts them back on its queues.
+ */
+struct ComponentMigration {
+    ComponentInfo* info;
+    uint32_t from;
+    uint32_t to;
+
+    /** Clock handlers, with the period of the Clock they were on */
+    std::vector<std::pair<TimeConverter*, Clock::HandlerBase*> > clocks;
+
+    struct PendingOneShot {
+        /** Delay factor of the OneShot */
+        SimTime_t delay;
+        /** Time the handler is due */
+        SimTime_t time;
+        OneShot::HandlerBase* handler;
+    };
+    /** OneShot handlers that have not been called yet */
+    std::vector<PendingOneShot> oneshots;
+
+    /** Links that received their events through the TimeVortex */
+    std::vector<Link*> tv_links;
+    /** Events in flight on those links */
+    std::vector<Activity*> events;
+
+    /** Statistics of the Component (NULL if it has none) */
+    std::vector<Statistics::StatisticBase*>* statistics;
+    /** Which of the statistics are event based, periodic or have a
+     * start or stop time still to come, with the time factor they
+     * were kept under */
+    std::vector<Statistics::StatisticBase*> event_statistics;
+    std::vector<std::pair<SimTime_t, Statistics::StatisticBase*> > periodic_statistics;
+    std::vector<std::pair<SimTime_t, Statistics::StatisticBase*> > start_statistics;
+    std::vector<std::pair<SimTime_t, Statistics::StatisticBase*> > stop_statistics;
+
+    ComponentMigration(ComponentInfo* info, uint32_t from, uint32_t to) :
+        info(info), from(from), to(to), statistics(NULL)
+    {}
+};
+
 
 /**
  * Main control class for a SST Simulation.
@@ -104,7 +152,13 @@ public:
      */
     static void shutdown();
     /** Return a pointer to the singleton instance of the Simulation */
-    static Simulation *getSimulation() { return instanceMap.at(std::this_thread::get_id()); }
+    static Simulation *getSimulation() { return instance; }
+    /** Return the current simulation cycle of the calling thread's
+     * Simulation.  Same as getSimulation()->getCurrentSimCycle() */
+    static SimTime_t getThreadSimCycle() { return instance->currentSimCycle; }
+    /** Return the TimeVortex of the calling thread's Simulation.  Same
+     * as getSimulation()->getTimeVortex() */
+    static TimeVortex* getThreadTimeVortex() { return instance->timeVortex; }
     /** Sets an internal flag for signaling the simulation.  Used internally */
     static void setSignal(int signal);
     /** Causes the current status of the simulation to be printed to stderr.
@@ -172,6 +226,11 @@ public:
     Exit* getExit() const { return m_exit; }
 
     const std::vector<SimTime_t>& getInterThreadLatencies() { return interThreadLatencies; }
+    /** Return the minimum latency of the links from thread from to
+     * thread to on this rank (MAX_SIMTIME_T if there are none) */
+    SimTime_t getInterThreadLatency(int from, int to) const { return interThreadLatencyMatrix[from][to]; }
+    /** Return the smallest latency in the inter-thread latency matrix */
+    SimTime_t getMinInterThreadLatency() const { return minInterThreadLatency; }
     static TimeConverter* getMinPartTC() { return minPartTC; }
 
     /** Return the TimeLord associated with this Simulation */
@@ -186,6 +245,16 @@ public:
     uint64_t getTimeVortexMaxDepth() const;
     uint64_t getTimeVortexCurrentDepth() const;
     uint64_t getSyncQueueDataSize() const;
+    /** Gets the number of Barrier waits and time spent in them, summed
+     *  over the threads of this Rank, and the longest time of any one
+     *  thread */
+    static void getBarrierWaitStats(uint64_t& waits, double& total_time, double& max_time);
+    /** Wall clock time, in seconds, this thread spent between syncs */
+    double getThreadBusyTime() const;
+    /** Number of thread load balance checks done on this rank, how
+     *  many of them found the threads out of balance, and how many
+     *  components were moved between threads as a result */
+    void getThreadBalanceChecks(uint64_t& checks, uint64_t& imbalanced, uint64_t& moved) const;
 
 
     /** Return the Statistic Processing Engine associated with this Simulation */
@@ -330,6 +399,13 @@ public:
      *  the Rank
      */
     static SimTime_t getLocalMinimumNextActivityTime();
+
+    /**
+     *  Gets the earliest time an event sent from one thread could be
+     *  delivered to another thread in the Rank, based on each
+     *  thread's next activity and its outgoing link latencies
+     */
+    static SimTime_t getLocalMinimumInterThreadDeliveryTime();
     
     /**
      * Returns the Simulation's SharedRegionManager
@@ -344,6 +420,7 @@ public:
 private:
     friend class Link;
     friend class Action;
+    friend class Clock;
     friend class Output;
     // To enable main to set up globals
     friend int ::main(int argc, char **argv);
@@ -381,6 +458,26 @@ private:
 
     TimeVortex* getTimeVortex() const { return timeVortex; }
 
+    /** Schedule a Clock to fire at a specified time.  Clocks are kept
+     * in the ClockRing rather than the TimeVortex. */
+    void insertClock(SimTime_t time, Clock* clock);
+
+    /** Derive interThreadLatencies, minInterThreadLatency and
+     * interThreadSendLatency from interThreadLatencyMatrix */
+    void computeInterThreadLatencies();
+
+    /** Take a Component that is moving to another thread off this
+     * thread.  Called by the thread it is leaving, while every thread
+     * is held in the SyncManager. */
+    void exportComponent(ComponentMigration& migration);
+    /** Put a Component taken off another thread with
+     * exportComponent() on this thread */
+    void importComponent(ComponentMigration& migration);
+    /** Return true if a Clock or OneShot handler on this thread was
+     * registered directly rather than by a Component.  Such handlers
+     * could not follow a Component to another thread. */
+    bool hasUnownedHandlers() const;
+
     /** Emergency Shutdown
      * Called when a SIGINT or SIGTERM has been seen
      */
@@ -400,12 +497,35 @@ private:
     
     Mode_t   runMode;
     TimeVortex*      timeVortex;
+    /** Scheduled Clocks, kept out of the TimeVortex */
+    ClockRing*       clockRing;
     TimeConverter*   threadMinPartTC;
     Activity*        current_activity;
+    /** Activities popped from the TimeVortex as one batch in run()
+     *  that have not yet been executed */
+    static const unsigned int DISPATCH_BATCH_SIZE = 64;
+    Activity*        dispatch_batch[DISPATCH_BATCH_SIZE];
+    unsigned int     dispatch_count;
+    unsigned int     dispatch_next;
     static SyncBase* sync;
     static TimeConverter*   minPartTC;
     std::vector<SimTime_t> interThreadLatencies;
+    /** Minimum link latency from each thread (first index) to each
+     *  other thread (second index) on this rank */
+    std::vector<std::vector<SimTime_t> > interThreadLatencyMatrix;
+    SimTime_t        minInterThreadLatency;
+    /** Minimum latency of the links leaving this thread */
+    SimTime_t        interThreadSendLatency;
+    /** Barrier wait statistics of the thread running this Simulation */
+    Core::ThreadSafe::BarrierWaitStats* barrierStats;
     SyncManager*     syncManager;
+    /** Name of the synchronization to use between threads */
+    std::string      threadSyncType;
+    /** Name of the synchronization to use between ranks */
+    std::string      rankSyncType;
+    /** Thread load balance check settings, handed to the SyncManager */
+    double           threadBalanceThreshold;
+    SimTime_t        threadBalancePeriod;
     ThreadSync*      threadSync;
     ComponentInfoMap compInfoMap;
     IntroMap_t       introMap;
@@ -431,9 +551,20 @@ private:
     bool             wireUpFinished;
     /** Statistics Timing Engine of the simulation */
     Statistics::StatisticProcessingEngine* statisticsEngine;
+    /** Count the traffic sent on each link */
+    bool             linkStatistics;
+    /** Per link traffic counters, output at the end of simulation */
+    std::vector<Statistics::LinkTrafficStatistic*> linkTrafficStats;
+
+    /** Attach traffic counters to the links of this thread's components */
+    void createLinkTrafficStatistics( ConfigGraph& graph, const RankInfo &myRank );
+    /** Output the link traffic counters */
+    void outputLinkTrafficStatistics();
 
     static std::unordered_map<std::thread::id, Simulation*> instanceMap;
     static std::vector<Simulation*> instanceVec;
+    /** The Simulation run by the calling thread */
+    static thread_local Simulation* instance;
 
     friend class boost::serialization::access;
     template<class Archive>
@@ -453,6 +584,7 @@ private:
     {
         ::new(t)Simulation();
         Simulation::instanceMap[std::this_thread::get_id()] = t;
+        Simulation::instance = t;
     }
 
     friend void wait_my_turn_start();
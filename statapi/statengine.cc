@@ -12,6 +12,8 @@
 #include <sst_config.h>
 #include <sst/core/serialization.h>
 
+#include <algorithm>
+
 #include <sst/core/timeLord.h>
 #include <sst/core/timeConverter.h>
 #include <sst/core/simulation.h>
@@ -209,6 +211,97 @@ void StatisticProcessingEngine::startOfSimulation()
     m_SimulationStarted = true;
 }
 
+void StatisticProcessingEngine::removeComponentStatistics(ComponentMigration& migration)
+{
+    SimTime_t now = Simulation::getSimulation()->getCurrentSimCycle();
+
+    CompStatMap_t::iterator it_c = m_CompStatMap.find(migration.info->getID());
+    if (it_c == m_CompStatMap.end()) {
+        migration.statistics = NULL;
+        return;
+    }
+    migration.statistics = it_c->second;
+    m_CompStatMap.erase(it_c);
+    const StatArray_t& stats = *migration.statistics;
+
+    for (StatArray_t::iterator it_v = m_EventStatisticArray.begin(); it_v != m_EventStatisticArray.end(); ) {
+        if (std::find(stats.begin(), stats.end(), *it_v) != stats.end()) {
+            migration.event_statistics.push_back(*it_v);
+            it_v = m_EventStatisticArray.erase(it_v);
+        } else {
+            ++it_v;
+        }
+    }
+
+    // Start and stop times that have already gone by have been handled,
+    // so those entries can stay behind
+    removeFromStatMap(m_PeriodicStatisticMap, stats, 0, migration.periodic_statistics);
+    removeFromStatMap(m_StartTimeMap, stats, now, migration.start_statistics);
+    removeFromStatMap(m_StopTimeMap, stats, now, migration.stop_statistics);
+}
+
+void StatisticProcessingEngine::addComponentStatistics(ComponentMigration& migration)
+{
+    Simulation*           sim = Simulation::getSimulation();
+    TimeLord*             timeLord = sim->getTimeLord();
+    SimTime_t             tcFactor;
+    StatArray_t*          statArray;
+
+    if (NULL == migration.statistics) {
+        return;
+    }
+    m_CompStatMap[migration.info->getID()] = migration.statistics;
+
+    m_EventStatisticArray.insert(m_EventStatisticArray.end(), migration.event_statistics.begin(), migration.event_statistics.end());
+
+    for (size_t x = 0; x < migration.periodic_statistics.size(); x++) {
+        tcFactor = migration.periodic_statistics[x].first;
+        if (m_PeriodicStatisticMap.find(tcFactor) == m_PeriodicStatisticMap.end()) {
+            // Statistics with a zero frequency are only output at the
+            // end, so they do not get a clock
+            if (0 != tcFactor) {
+                Clock::HandlerBase* ClockHandler = new Clock::Handler<StatisticProcessingEngine, SimTime_t>(this,
+                                                   &StatisticProcessingEngine::handleStatisticEngineClockEvent, tcFactor);
+                registerClock(timeLord->getTimeBase() * tcFactor, ClockHandler, STATISTICCLOCKPRIORITY);
+            }
+            m_PeriodicStatisticMap[tcFactor] = new std::vector<StatisticBase*>();
+        }
+        m_PeriodicStatisticMap[tcFactor]->push_back(migration.periodic_statistics[x].second);
+    }
+
+    // The start and stop OneShots were registered at time zero, so
+    // their factors are also the times they fire
+    for (size_t x = 0; x < migration.start_statistics.size(); x++) {
+        tcFactor = migration.start_statistics[x].first;
+        if (m_StartTimeMap.find(tcFactor) == m_StartTimeMap.end()) {
+            OneShot::HandlerBase* OneShotHandler = new OneShot::Handler<StatisticProcessingEngine, SimTime_t>(this,
+                                                   &StatisticProcessingEngine::handleStatisticEngineStartTimeEvent, tcFactor);
+            if (m_StartTimeOneShotMap.find(tcFactor) == m_StartTimeOneShotMap.end()) {
+                m_StartTimeOneShotMap[tcFactor] = new OneShot(timeLord->getTimeConverter(timeLord->getTimeBase() * tcFactor), STATISTICCLOCKPRIORITY);
+            }
+            m_StartTimeOneShotMap[tcFactor]->registerHandlerAt(tcFactor, OneShotHandler);
+            m_StartTimeMap[tcFactor] = new std::vector<StatisticBase*>();
+        }
+        statArray = m_StartTimeMap[tcFactor];
+        statArray->push_back(migration.start_statistics[x].second);
+    }
+
+    for (size_t x = 0; x < migration.stop_statistics.size(); x++) {
+        tcFactor = migration.stop_statistics[x].first;
+        if (m_StopTimeMap.find(tcFactor) == m_StopTimeMap.end()) {
+            OneShot::HandlerBase* OneShotHandler = new OneShot::Handler<StatisticProcessingEngine, SimTime_t>(this,
+                                                   &StatisticProcessingEngine::handleStatisticEngineStopTimeEvent, tcFactor);
+            if (m_StopTimeOneShotMap.find(tcFactor) == m_StopTimeOneShotMap.end()) {
+                m_StopTimeOneShotMap[tcFactor] = new OneShot(timeLord->getTimeConverter(timeLord->getTimeBase() * tcFactor), STATISTICCLOCKPRIORITY);
+            }
+            m_StopTimeOneShotMap[tcFactor]->registerHandlerAt(tcFactor, OneShotHandler);
+            m_StopTimeMap[tcFactor] = new std::vector<StatisticBase*>();
+        }
+        statArray = m_StopTimeMap[tcFactor];
+        statArray->push_back(migration.stop_statistics[x].second);
+    }
+}
+
 TimeConverter* StatisticProcessingEngine::registerClock(const UnitAlgebra& freq, Clock::HandlerBase* handler, int priority)
 {
     Simulation* sim = Simulation::getSimulation();
@@ -371,6 +464,21 @@ StatisticBase* StatisticProcessingEngine::isStatisticInCompStatMap(const std::st
     return NULL;
 }
 
+void StatisticProcessingEngine::removeFromStatMap(StatMap_t& statMap, const StatArray_t& stats, SimTime_t earliest, std::vector<std::pair<SimTime_t, StatisticBase*> >& removed)
+{
+    for (StatMap_t::iterator it_m = statMap.lower_bound(earliest); it_m != statMap.end(); it_m++) {
+        StatArray_t* statArray = it_m->second;
+        for (StatArray_t::iterator it_v = statArray->begin(); it_v != statArray->end(); ) {
+            if (std::find(stats.begin(), stats.end(), *it_v) != stats.end()) {
+                removed.push_back(std::make_pair(it_m->first, *it_v));
+                it_v = statArray->erase(it_v);
+            } else {
+                ++it_v;
+            }
+        }
+    }
+}
+
 void StatisticProcessingEngine::addStatisticToCompStatMap(const ComponentId_t& compId, StatisticBase* Stat, StatisticFieldInfo::fieldType_t fieldType)
 {
     StatArray_t*        statArray;
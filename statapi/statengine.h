@@ -20,6 +20,7 @@
 namespace SST {
 class Component;
 class Simulation;
+struct ComponentMigration;
 namespace Statistics {
     
 class StatisticBase;
@@ -54,6 +55,13 @@ private:
 
     void endOfSimulation();
     void startOfSimulation();
+
+    /** Take the statistics of a Component that is moving to another
+     * thread out of this engine and record them in migration */
+    void removeComponentStatistics(ComponentMigration& migration);
+    /** Add the statistics recorded by removeComponentStatistics() on
+     * the thread the Component moved from */
+    void addComponentStatistics(ComponentMigration& migration);
     
     template<typename T>
     void registerStatisticWithEngine(const ComponentId_t& compId, StatisticBase* Stat)
@@ -110,6 +118,8 @@ private:
     OneShotMap_t                              m_StopTimeOneShotMap;   /*!< Map of OneShots for the Statistics stop time */
     CompStatMap_t                             m_CompStatMap;          /*!< Map of Arrays of Statistics tied to Component Id's */  
     bool                                      m_SimulationStarted;    /*!< Flag showing if Simulation has started */
+
+    void removeFromStatMap(StatMap_t& statMap, const StatArray_t& stats, SimTime_t earliest, std::vector<std::pair<SimTime_t, StatisticBase*> >& removed);
     
     // Serialization
     friend class boost::serialization::access;
@@ -0,0 +1,99 @@
+// Copyright 2009-2015 Sandia Corporation. Under the terms
+// of Contract DE-AC04-94AL85000 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2015, Sandia Corporation
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_CORE_LINK_TRAFFIC_STATISTIC_
+#define _H_SST_CORE_LINK_TRAFFIC_STATISTIC_
+
+#include <sst/core/sst_types.h>
+
+#include <sst/core/event.h>
+#include <sst/core/statapi/statbase.h>
+#include <sst/core/statapi/statoutput.h>
+
+namespace SST {
+class Link;
+class Simulation;
+namespace Statistics {
+
+/**
+	\class LinkTrafficStatistic
+
+	Core statistic counting the traffic sent by a component on one
+	side of a Link: number of events, bytes (for events that report a
+	size) and the times of the first and last send.  Only updated by
+	the thread that owns the sending component, so the counters are
+	plain integers.  Created by the Simulation when link statistics
+	are enabled and output once, at the end of simulation.
+*/
+class LinkTrafficStatistic : public StatisticBase
+{
+public:
+    ~LinkTrafficStatistic() {}
+
+    /** Count an event sent at time now */
+    inline void record(SimTime_t now, Event* event)
+    {
+        if ( 0 == m_events ) m_firstSend = now;
+        m_lastSend = now;
+        m_events++;
+        m_bytes += event->getTrafficBytes();
+    }
+
+private:
+    friend class SST::Simulation;
+
+    LinkTrafficStatistic(Component* comp, std::string& statName, std::string& statSubId, Params& statParams)
+		: StatisticBase(comp, statName, statSubId, statParams),
+          m_events(0), m_bytes(0), m_firstSend(0), m_lastSend(0)
+    {
+        // Set the Name of this Statistic
+        setStatisticTypeName("LinkTraffic");
+        setStatisticDataType(StatisticFieldInfo::UINT64);
+    }
+
+    void clearStatisticData()
+    {
+        m_events = 0;
+        m_bytes = 0;
+        m_firstSend = 0;
+        m_lastSend = 0;
+    }
+
+    void registerOutputFields(StatisticOutput* statOutput)
+    {
+        Field1 = statOutput->registerField<uint64_t>("Events");
+        Field2 = statOutput->registerField<uint64_t>("Bytes");
+        Field3 = statOutput->registerField<uint64_t>("FirstSend");
+        Field4 = statOutput->registerField<uint64_t>("LastSend");
+    }
+
+    void outputStatisticData(StatisticOutput* statOutput, bool EndOfSimFlag)
+    {
+        statOutput->outputField(Field1, m_events);
+        statOutput->outputField(Field2, m_bytes);
+        statOutput->outputField(Field3, m_firstSend);
+        statOutput->outputField(Field4, m_lastSend);
+    }
+
+private:
+    uint64_t m_events;
+    uint64_t m_bytes;
+    SimTime_t m_firstSend;
+    SimTime_t m_lastSend;
+
+    StatisticOutput::fieldHandle_t Field1, Field2, Field3, Field4;
+};
+
+} //namespace Statistics
+} //namespace SST
+
+#endif
@@ -285,13 +285,9 @@ SyncD::execute(void)
         }
         
         auto deserialStart = SST::Core::Profile::now();
-        boost::iostreams::basic_array_source<char> source(&buffer[sizeof(SyncQueue::Header)],size-sizeof(SyncQueue::Header));
-        boost::iostreams::stream<boost::iostreams::basic_array_source <char> > input_stream(source);
-        boost::archive::polymorphic_binary_iarchive ia(input_stream, boost::archive::no_header | boost::archive::no_tracking );
-        deserializeTime += SST::Core::Profile::getElapsed(deserialStart);
-
         std::vector<Activity*> activities;
-        ia >> activities;
+        SyncQueue::extractActivities(buffer, activities);
+        deserializeTime += SST::Core::Profile::getElapsed(deserialStart);
         for ( unsigned int j = 0; j < activities.size(); j++ ) {
             
             Event* ev = static_cast<Event*>(activities[j]);
@@ -421,12 +417,8 @@ SyncD::exchangeLinkInitData(int msg_count)
             buffer = i->second.rbuf;
         }
         
-        boost::iostreams::basic_array_source<char> source(&buffer[sizeof(SyncQueue::Header)],size-sizeof(SyncQueue::Header));
-        boost::iostreams::stream<boost::iostreams::basic_array_source <char> > input_stream(source);
-        boost::archive::polymorphic_binary_iarchive ia(input_stream, boost::archive::no_header | boost::archive::no_tracking );
-        
         std::vector<Activity*> activities;
-        ia >> activities;
+        SyncQueue::extractActivities(buffer, activities);
         for ( unsigned int j = 0; j < activities.size(); j++ ) {
             
             Event* ev = static_cast<Event*>(activities[j]);
@@ -14,20 +14,29 @@
 #include "sst/core/syncManager.h"
 
 #include "sst/core/exit.h"
+#include "sst/core/linkMap.h"
 #include "sst/core/simulation.h"
 #include "sst/core/syncBase.h"
 #include "sst/core/threadSyncQueue.h"
 #include "sst/core/timeConverter.h"
 
+#include "sst/core/rankSyncParallelSkip.h"
 #include "sst/core/rankSyncSerialSkip.h"
+#include "sst/core/threadSyncCMB.h"
+#include "sst/core/threadSyncDirectSkip.h"
 #include "sst/core/threadSyncSimpleSkip.h"
 
+#include <unordered_set>
+
 namespace SST {
 
 // Static data members
 std::mutex SyncManager::sync_mutex;
 NewRankSync* SyncManager::rankSync = NULL;
 SimTime_t SyncManager::next_rankSync = MAX_SIMTIME_T;
+GlobalReduction SyncManager::rankSyncReduction;
+std::vector<SyncManager*> SyncManager::managers;
+std::vector<ComponentMigration*> SyncManager::migrations;
 
 class EmptyRankSync : public NewRankSync {
 public:
@@ -69,18 +78,34 @@ public:
 };
 
 
-SyncManager::SyncManager(const RankInfo& rank, const RankInfo& num_ranks, Core::ThreadSafe::Barrier& barrier, TimeConverter* minPartTC, const std::vector<SimTime_t>& interThreadLatencies) :
+SyncManager::SyncManager(const RankInfo& rank, const RankInfo& num_ranks, Core::ThreadSafe::Barrier& barrier, TimeConverter* minPartTC, const std::vector<SimTime_t>& interThreadLatencies, const std::string& threadSyncType, const std::string& rankSyncType) :
     Action(),
     rank(rank),
     num_ranks(num_ranks),
     barrier(barrier),
     threadSync(NULL),
-    next_threadSync(0)
+    next_threadSync(0),
+    busy_ns(0),
+    running(false),
+    balance_threshold(0.0),
+    balance_period(MAX_SIMTIME_T),
+    next_balance_check(MAX_SIMTIME_T),
+    balance_checks(0),
+    balance_imbalanced(0),
+    balance_moved(0)
 {
     // TraceFunction trace(CALL_INFO_LONG);    
     if ( rank.thread == 0  ) {
         if ( num_ranks.rank > 1 ) {
-            rankSync = new RankSyncSerialSkip(barrier, minPartTC);
+            if ( rankSyncType == "serial" ) {
+                rankSync = new RankSyncSerialSkip(barrier, minPartTC);
+            }
+            else if ( rankSyncType == "parallel" ) {
+                rankSync = new RankSyncParallelSkip(barrier, minPartTC);
+            }
+            else {
+                Simulation::getSimulation()->getSimulationOutput().fatal(CALL_INFO, 1, "Unknown rank sync: %s\n", rankSyncType.c_str());
+            }
         }
         else {
             rankSync = new EmptyRankSync();
@@ -89,7 +114,18 @@ SyncManager::SyncManager(const RankInfo& rank, const RankInfo& num_ranks, Core::
     }
 
     if ( num_ranks.thread > 1 ) {
-        threadSync = new ThreadSyncSimpleSkip(num_ranks.thread, rank.thread, Simulation::getSimulation());
+        if ( threadSyncType == "simple" ) {
+            threadSync = new ThreadSyncSimpleSkip(num_ranks.thread, rank.thread, Simulation::getSimulation());
+        }
+        else if ( threadSyncType == "direct" ) {
+            threadSync = new ThreadSyncDirectSkip(num_ranks.thread, rank.thread, Simulation::getSimulation());
+        }
+        else if ( threadSyncType == "cmb" ) {
+            threadSync = new ThreadSyncCMB(num_ranks.thread, rank.thread, Simulation::getSimulation());
+        }
+        else {
+            Simulation::getSimulation()->getSimulationOutput().fatal(CALL_INFO, 1, "Unknown thread sync: %s\n", threadSyncType.c_str());
+        }
     }
     else {
         threadSync = new EmptyThreadSync();
@@ -98,6 +134,14 @@ SyncManager::SyncManager(const RankInfo& rank, const RankInfo& num_ranks, Core::
     sim = Simulation::getSimulation();
     exit = sim->getExit();
 
+    // Exit gets the state of the other ranks from the rank sync's
+    // reduction rather than its own collectives
+    if ( exit != NULL && rank.thread == 0 && num_ranks.rank > 1 ) exit->setReduction(rankSyncReduction);
+
+    // The SyncManagers are created by all the threads at once
+    std::lock_guard<std::mutex> lock(sync_mutex);
+    if ( managers.size() < num_ranks.thread ) managers.resize(num_ranks.thread, NULL);
+    managers[rank.thread] = this;
 }
 
 
@@ -136,11 +180,25 @@ SyncManager::registerLink(const RankInfo& to_rank, const RankInfo& from_rank, Li
 void
 SyncManager::execute(void)
 {
+    // Time since the end of the last sync is time this thread spent
+    // doing work.  The very first interval also covers setup, so it is
+    // not counted.
+    std::chrono::steady_clock::time_point sync_start = std::chrono::steady_clock::now();
+    if ( running ) {
+        busy_ns.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(sync_start - last_sync_end).count(),
+                          std::memory_order_relaxed);
+    }
+    running = true;
+
     // TraceFunction trace(CALL_INFO_LONG);    
     // trace.getOutput().output(CALL_INFO, "next_sync_type @ switch = %d\n", next_sync_type);
     switch ( next_sync_type ) {
     case RANK:
 
+        // Threads waiting on this one in the ThreadSync must be able
+        // to get here too
+        threadSync->publishLowerBound(sim->getCurrentSimCycle());
+
         // Need to make sure all threads have reached the sync to
         // guarantee that all events have been sent to the appropriate
         // queues.
@@ -178,7 +236,7 @@ SyncManager::execute(void)
 
         threadSync->execute();
 
-        if ( num_ranks.rank == 1 ) {
+        if ( num_ranks.rank == 1 && !threadSync->handlesEnd() ) {
             if ( exit->getRefCount() == 0 ) {
                 endSimulation(exit->getEndTime());
             }
@@ -189,8 +247,23 @@ SyncManager::execute(void)
     default:
         break;
     }
+    if ( sim->getCurrentSimCycle() >= next_balance_check ) {
+        SimTime_t now = sim->getCurrentSimCycle();
+        next_balance_check = (now < MAX_SIMTIME_T - balance_period) ? now + balance_period : MAX_SIMTIME_T;
+        if ( threadSync->canMoveComponents() ) {
+            balanceLoad();
+        }
+        else if ( rank.thread == 0 ) {
+            // The other threads are not stopped at this time, so the
+            // imbalance can only be reported
+            std::vector<uint64_t> busy;
+            checkLoadBalance(busy);
+        }
+    }
+
     computeNextInsert();
     // trace.getOutput().output(CALL_INFO, "next_sync_type = %d\n", next_sync_type);
+    last_sync_end = std::chrono::steady_clock::now();
 }
 
 /** Cause an exchange of Initialization Data to occur */
@@ -219,6 +292,366 @@ SyncManager::finalizeLinkConfigurations()
     computeNextInsert();
 }
 
+void
+SyncManager::stopSending()
+{
+    threadSync->publishLowerBound(MAX_SIMTIME_T);
+}
+
+void
+SyncManager::finish()
+{
+    if ( rank.thread == 0 ) rankSync->finish();
+}
+
+void
+SyncManager::setLoadBalanceCheck(double threshold, SimTime_t period)
+{
+    if ( threshold <= 0.0 || num_ranks.thread == 1 ) return;
+    balance_threshold = threshold;
+    balance_period = period;
+    next_balance_check = period;
+    balance_snapshot.resize(num_ranks.thread, 0);
+}
+
+void
+SyncManager::getLoadBalanceChecks(uint64_t& checks, uint64_t& imbalanced, uint64_t& moved) const
+{
+    checks = balance_checks;
+    imbalanced = balance_imbalanced;
+    moved = balance_moved;
+}
+
+bool
+SyncManager::checkLoadBalance(std::vector<uint64_t>& busy)
+{
+    // Unless the ThreadSync stops every thread at the same time, the
+    // other threads may still be running, so this only sees the busy
+    // time up to their last sync, which is good enough to spot a
+    // thread that is consistently doing more of the work
+    uint64_t total = 0;
+    uint64_t max = 0;
+    uint32_t busiest = 0;
+    busy.resize(num_ranks.thread);
+    for ( uint32_t i = 0; i < num_ranks.thread; i++ ) {
+        uint64_t now_busy = managers[i]->busy_ns.load(std::memory_order_relaxed);
+        busy[i] = now_busy - balance_snapshot[i];
+        balance_snapshot[i] = now_busy;
+        total += busy[i];
+        if ( busy[i] > max ) {
+            max = busy[i];
+            busiest = i;
+        }
+    }
+
+    if ( total == 0 ) return false;
+
+    balance_checks++;
+    double ratio = (double)max * num_ranks.thread / total;
+    if ( ratio > balance_threshold ) {
+        balance_imbalanced++;
+        sim->getSimulationOutput().verbose(CALL_INFO, 1, 0,
+                "Thread load imbalance on rank %u at %s: thread %u was busy %.2f times the average\n",
+                rank.rank, sim->getElapsedSimTime().toStringBestSI().c_str(), busiest, ratio);
+        return true;
+    }
+    return false;
+}
+
+void
+SyncManager::balanceLoad()
+{
+    // Every thread gets here at the same simulated time, and nothing
+    // runs between the barriers below, so Components can be moved
+    // while the threads are held here
+    barrier.wait();
+    if ( rank.thread == 0 ) {
+        std::vector<uint64_t> busy;
+        if ( checkLoadBalance(busy) ) planMigrations(busy);
+    }
+    barrier.wait();
+    if ( migrations.empty() ) return;
+
+    // Each thread takes the Components it is losing off its queues
+    for ( size_t i = 0; i < migrations.size(); i++ ) {
+        if ( migrations[i]->from == rank.thread ) sim->exportComponent(*migrations[i]);
+    }
+    barrier.wait();
+
+    // Thread 0 moves the Links over, in the order the moves were
+    // planned
+    if ( rank.thread == 0 ) {
+        for ( size_t i = 0; i < migrations.size(); i++ ) {
+            rewireComponent(*migrations[i]);
+        }
+    }
+    barrier.wait();
+
+    for ( size_t i = 0; i < migrations.size(); i++ ) {
+        if ( migrations[i]->to == rank.thread ) sim->importComponent(*migrations[i]);
+    }
+    barrier.wait();
+
+    // The links between threads have changed, so the lookahead has to
+    // be worked out again before the next sync time is
+    updateInterThreadLatencies();
+    threadSync->updateLinks();
+    barrier.wait();
+    threadSync->after();
+
+    // after() ends in a barrier, so nobody is using the list anymore
+    if ( rank.thread == 0 ) {
+        balance_moved += migrations.size();
+        for ( size_t i = 0; i < migrations.size(); i++ ) {
+            delete migrations[i];
+        }
+        migrations.clear();
+    }
+}
+
+void
+SyncManager::planMigrations(const std::vector<uint64_t>& busy)
+{
+    uint32_t num_threads = num_ranks.thread;
+
+    // Component on each end of every Link between Components on this
+    // rank.  For Links between threads, the other end is found
+    // through the sync side Links.
+    std::unordered_map<Link*, ComponentInfo*> owners;
+    std::unordered_map<ComponentInfo*, uint32_t> thread_of;
+    std::vector<std::vector<ComponentInfo*> > components(num_threads);
+    for ( uint32_t t = 0; t < num_threads; t++ ) {
+        const ComponentInfoMap& infos = Simulation::instanceVec[t]->compInfoMap;
+        for ( ComponentInfoMap::const_iterator it = infos.begin(); it != infos.end(); ++it ) {
+            ComponentInfo* info = *it;
+            components[t].push_back(info);
+            thread_of[info] = t;
+            std::map<std::string,Link*>& links = info->getLinkMap()->getLinkMap();
+            for ( std::map<std::string,Link*>::iterator l_it = links.begin(); l_it != links.end(); ++l_it ) {
+                owners[l_it->second] = info;
+            }
+        }
+    }
+
+    struct Peer {
+        Link* link;
+        Link* peer_link;
+        ComponentInfo* peer;
+    };
+    std::unordered_map<ComponentInfo*, std::vector<Peer> > peers;
+    // Components with a Link to another rank stay where they are, as
+    // do all Components of a thread with handlers (e.g. from an
+    // Introspector) that cannot be attributed to any one of them
+    std::unordered_set<ComponentInfo*> pinned;
+    for ( uint32_t t = 0; t < num_threads; t++ ) {
+        if ( Simulation::instanceVec[t]->hasUnownedHandlers() ) {
+            pinned.insert(components[t].begin(), components[t].end());
+        }
+        for ( size_t c = 0; c < components[t].size(); c++ ) {
+            ComponentInfo* info = components[t][c];
+            std::map<std::string,Link*>& links = info->getLinkMap()->getLinkMap();
+            for ( std::map<std::string,Link*>::iterator l_it = links.begin(); l_it != links.end(); ++l_it ) {
+                Peer peer = { l_it->second, l_it->second->pair_link, NULL };
+                if ( owners.count(peer.peer_link) == 0 ) {
+                    for ( uint32_t r = 0; r < num_threads; r++ ) {
+                        if ( r == t ) continue;
+                        NewThreadSync* remote = managers[r]->threadSync;
+                        if ( remote->getQueueForThread(t) != peer.peer_link->recvQueue ) continue;
+                        Link* remote_link = remote->getRegisteredLink(peer.link->id);
+                        if ( remote_link != NULL ) peer.peer_link = remote_link->pair_link;
+                        break;
+                    }
+                }
+                auto owner = owners.find(peer.peer_link);
+                if ( owner == owners.end() ) {
+                    pinned.insert(info);
+                    break;
+                }
+                peer.peer = owner->second;
+                if ( peer.peer != info ) peers[info].push_back(peer);
+            }
+        }
+    }
+
+    // Time each Component took, assuming the Components of a thread
+    // share its busy time evenly
+    std::vector<double> load(num_threads);
+    std::vector<double> cost(num_threads);
+    for ( uint32_t t = 0; t < num_threads; t++ ) {
+        load[t] = busy[t];
+        cost[t] = components[t].empty() ? 0.0 : (double)busy[t] / components[t].size();
+    }
+
+    // Move Components from the busiest thread to the least busy one
+    // for as long as that narrows the gap between them.  Of the
+    // Components that can move, the one with the most Links to the
+    // other thread goes first.
+    std::unordered_set<ComponentInfo*> moved;
+    while ( true ) {
+        uint32_t src = 0;
+        uint32_t dst = 0;
+        for ( uint32_t t = 1; t < num_threads; t++ ) {
+            if ( load[t] > load[src] ) src = t;
+            if ( load[t] < load[dst] ) dst = t;
+        }
+        if ( components[src].size() <= 1 || load[src] - load[dst] <= cost[src] ) break;
+
+        ComponentInfo* best = NULL;
+        size_t best_index = 0;
+        int best_gain = 0;
+        for ( size_t c = 0; c < components[src].size(); c++ ) {
+            ComponentInfo* info = components[src][c];
+            if ( moved.count(info) || pinned.count(info) ) continue;
+
+            int gain = 0;
+            bool can_move = true;
+            std::vector<Peer>& links = peers[info];
+            for ( size_t l = 0; l < links.size(); l++ ) {
+                uint32_t peer_thread = thread_of[links[l].peer];
+                if ( peer_thread == dst ) {
+                    gain++;
+                    continue;
+                }
+                if ( peer_thread == src ) gain--;
+                // Links between threads need some latency for the
+                // ThreadSync to work with
+                if ( links[l].link->latency == 0 || links[l].peer_link->latency == 0 ) can_move = false;
+            }
+            if ( !can_move ) continue;
+            if ( best == NULL || gain > best_gain ||
+                 (gain == best_gain && info->getID() < best->getID()) ) {
+                best = info;
+                best_index = c;
+                best_gain = gain;
+            }
+        }
+        if ( best == NULL ) break;
+
+        migrations.push_back(new ComponentMigration(best, src, dst));
+        moved.insert(best);
+        components[src].erase(components[src].begin() + best_index);
+        components[dst].push_back(best);
+        thread_of[best] = dst;
+        load[src] -= cost[src];
+        load[dst] += cost[src];
+    }
+
+    for ( size_t i = 0; i < migrations.size(); i++ ) {
+        sim->getSimulationOutput().verbose(CALL_INFO, 1, 0,
+                "Moving component %s on rank %u from thread %u to thread %u\n",
+                migrations[i]->info->getName().c_str(), rank.rank, migrations[i]->from, migrations[i]->to);
+    }
+}
+
+void
+SyncManager::rewireComponent(ComponentMigration& migration)
+{
+    NewThreadSync* from_sync = managers[migration.from]->threadSync;
+    NewThreadSync* to_sync = managers[migration.to]->threadSync;
+
+    std::map<std::string,Link*>& links = migration.info->getLinkMap()->getLinkMap();
+    std::unordered_set<Link*> own_links;
+    for ( std::map<std::string,Link*>::iterator it = links.begin(); it != links.end(); ++it ) {
+        own_links.insert(it->second);
+    }
+
+    for ( std::map<std::string,Link*>::iterator it = links.begin(); it != links.end(); ++it ) {
+        Link* link = it->second;
+        LinkId_t id = link->id;
+        if ( own_links.count(link->pair_link) ) continue;
+
+        Link* sync_link = from_sync->getRegisteredLink(id);
+        if ( sync_link == NULL ) {
+            // The other end was on the same thread, so the link now
+            // crosses threads.  Each side gets a sync side Link that
+            // sends into the other thread's queue, set up the way
+            // performWireUp() does it.
+            Link* peer = link->pair_link;
+            to_sync->registerLink(id, createSyncLink(id, link, from_sync->getQueueForThread(migration.to)));
+            from_sync->registerLink(id, createSyncLink(id, peer, to_sync->getQueueForThread(migration.from)));
+            continue;
+        }
+
+        uint32_t peer_thread = 0;
+        for ( uint32_t t = 0; t < num_ranks.thread; t++ ) {
+            if ( t != migration.from && managers[t]->threadSync->getQueueForThread(migration.from) == sync_link->recvQueue ) {
+                peer_thread = t;
+                break;
+            }
+        }
+        NewThreadSync* peer_sync = managers[peer_thread]->threadSync;
+        Link* remote = peer_sync->getRegisteredLink(id);
+
+        if ( peer_thread == migration.to ) {
+            // Both ends are on the same thread now.  The receive
+            // latencies that were added to the sync side Links move
+            // onto the Links they were added for.
+            Link* peer = remote->pair_link;
+            link->latency += remote->latency;
+            peer->latency += sync_link->latency;
+            link->pair_link = peer;
+            peer->pair_link = link;
+            from_sync->unregisterLink(id);
+            to_sync->unregisterLink(id);
+            delete sync_link;
+            delete remote;
+        }
+        else {
+            // Still crosses threads, but from the new thread
+            from_sync->unregisterLink(id);
+            to_sync->registerLink(id, sync_link);
+            sync_link->recvQueue = peer_sync->getQueueForThread(migration.to);
+            remote->recvQueue = to_sync->getQueueForThread(peer_thread);
+        }
+    }
+
+    if ( exit != NULL ) exit->refMove(migration.info->getID(), migration.from, migration.to);
+}
+
+Link*
+SyncManager::createSyncLink(LinkId_t link_id, Link* pair, ActivityQueue* queue)
+{
+    Link* link = new Link(link_id);
+    link->pair_link = pair;
+    pair->pair_link = link;
+    link->setLatency(0);
+    link->setDefaultTimeBase(sim->minPartToTC(1));
+    // Already past init, so this is what finalizeConfiguration()
+    // would have left
+    link->recvQueue = queue;
+    link->configuredQueue = NULL;
+    link->initQueue = Link::afterInitQueue;
+    return link;
+}
+
+void
+SyncManager::updateInterThreadLatencies()
+{
+    // Same as Simulation::processGraphInfo(), but from the Links
+    // rather than the ConfigGraph.  A Link to another thread is
+    // paired with a sync side Link that sends into that thread's
+    // queue.
+    uint32_t num_threads = num_ranks.thread;
+    std::vector<std::vector<SimTime_t> >& matrix = sim->interThreadLatencyMatrix;
+    matrix.assign(num_threads, std::vector<SimTime_t>(num_threads, MAX_SIMTIME_T));
+    for ( uint32_t from = 0; from < num_threads; from++ ) {
+        const ComponentInfoMap& infos = Simulation::instanceVec[from]->compInfoMap;
+        for ( ComponentInfoMap::const_iterator it = infos.begin(); it != infos.end(); ++it ) {
+            std::map<std::string,Link*>& links = (*it)->getLinkMap()->getLinkMap();
+            for ( std::map<std::string,Link*>::iterator l_it = links.begin(); l_it != links.end(); ++l_it ) {
+                Link* link = l_it->second;
+                for ( uint32_t to = 0; to < num_threads; to++ ) {
+                    if ( to == from ) continue;
+                    if ( managers[to]->threadSync->getQueueForThread(from) != link->pair_link->recvQueue ) continue;
+                    if ( link->latency < matrix[from][to] ) matrix[from][to] = link->latency;
+                    break;
+                }
+            }
+        }
+    }
+    sim->computeInterThreadLatencies();
+}
+
 void
 SyncManager::computeNextInsert()
 {
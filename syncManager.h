@@ -15,10 +15,13 @@
 #include "sst/core/sst_types.h"
 
 #include "sst/core/action.h"
+#include "sst/core/globalReduction.h"
 #include "sst/core/link.h"
 #include "sst/core/rankInfo.h"
 #include "sst/core/threadsafe.h"
 
+#include <chrono>
+#include <string>
 #include <vector>
 #include <unordered_map>
 
@@ -26,6 +29,7 @@ namespace SST {
 
 class Exit;
 class Simulation;
+struct ComponentMigration;
 class SyncBase;
 class ThreadSyncQueue;
 class TimeConverter;
@@ -41,6 +45,8 @@ public:
     virtual void execute(int thread) = 0;
     virtual void exchangeLinkInitData(int thread, std::atomic<int>& msg_count) = 0;
     virtual void finalizeLinkConfigurations() = 0;
+    /** Called by thread 0 once the run is over */
+    virtual void finish() {}
 
     virtual SimTime_t getNextSyncTime() { return nextSyncTime; }
 
@@ -61,6 +67,12 @@ protected:
         link->sendInitData_sync(init_data);
     }
 
+    /** Have events on the link sent with the slot in place of the link
+     * id.  The slot must mean the same link on the remote rank. */
+    void setSyncSlot(Link* link, LinkId_t slot) {
+        link->sync_slot = slot;
+    }
+
 private:
     
 };
@@ -84,6 +96,29 @@ public:
     /** Register a Link which this Sync Object is responsible for */
     virtual void registerLink(LinkId_t link_id, Link* link) = 0;
     virtual ActivityQueue* getQueueForThread(int tid) = 0;
+
+    /** Called before this thread waits on all the other threads
+     * outside of the ThreadSync (at a rank sync or the end of
+     * simulation).  Time is the earliest this thread can still send
+     * an event. */
+    virtual void publishLowerBound(SimTime_t time) {}
+
+    /** Whether this ThreadSync ends a single rank simulation itself.
+     * Otherwise the SyncManager ends it at the first thread sync
+     * after the last reference to the Exit is released, which is only
+     * right if every thread runs the sync at the same simulated time. */
+    virtual bool handlesEnd() const { return false; }
+
+    /** Whether every thread runs each sync at the same simulated
+     * time, so Components can be moved between threads there */
+    virtual bool canMoveComponents() const { return false; }
+    /** Return the Link registered for link_id (NULL if none) */
+    virtual Link* getRegisteredLink(LinkId_t link_id) { return NULL; }
+    /** Forget the Link registered for link_id */
+    virtual void unregisterLink(LinkId_t link_id) {}
+    /** Called by every thread after Components have moved between
+     * threads, once all of the Links have been rewired */
+    virtual void updateLinks() {}
     
 protected:
     SimTime_t nextSyncTime;
@@ -102,9 +137,13 @@ private:
 
 class SyncManager : public Action {
 public:
-    SyncManager(const RankInfo& rank, const RankInfo& num_ranks, Core::ThreadSafe::Barrier& barrier, TimeConverter* minPartTC, const std::vector<SimTime_t>& interThreadLatencies);
+    SyncManager(const RankInfo& rank, const RankInfo& num_ranks, Core::ThreadSafe::Barrier& barrier, TimeConverter* minPartTC, const std::vector<SimTime_t>& interThreadLatencies, const std::string& threadSyncType, const std::string& rankSyncType);
     virtual ~SyncManager();
 
+    /** busy_ns is CACHE_ALIGNED, which plain new does not honour */
+    static void* operator new(size_t size) { return Core::ThreadSafe::allocCacheAligned(size); }
+    static void operator delete(void* ptr) { free(ptr); }
+
     /** Register a Link which this Sync Object is responsible for */
     ActivityQueue* registerLink(const RankInfo& to_rank, const RankInfo& from_rank, LinkId_t link_id, Link* link);
     void execute(void);
@@ -113,6 +152,28 @@ public:
     void exchangeLinkInitData(std::atomic<int>& msg_count);
     /** Finish link configuration */
     void finalizeLinkConfigurations();
+    /** Tell the ThreadSync this thread will not send any more events */
+    void stopSending();
+    /** Clean up the syncs once the run is over */
+    void finish();
+
+    /** Compare the busy time of the threads of this rank every period
+     * of simulated time.  When the busiest thread was busy more than
+     * threshold times the average, Components are moved off it if the
+     * ThreadSync allows it, and the interval is reported.  A
+     * threshold of 0 disables the checks. */
+    void setLoadBalanceCheck(double threshold, SimTime_t period);
+    /** Wall clock time, in seconds, this thread spent between syncs */
+    double getBusyTime() const { return busy_ns.load(std::memory_order_relaxed) * 1e-9; }
+    /** Number of load balance checks done, how many of them found the
+     * threads out of balance, and how many Components were moved */
+    void getLoadBalanceChecks(uint64_t& checks, uint64_t& imbalanced, uint64_t& moved) const;
+
+    /** Reduction done by the RankSync at every rank sync.  Core
+     * services that need a global value at each sync add their fields
+     * to it, from thread 0 and before the run starts, instead of
+     * making collectives of their own. */
+    static GlobalReduction& getRankSyncReduction() { return rankSyncReduction; }
 
 private:
     enum sync_type_t { RANK, THREAD}; 
@@ -126,6 +187,7 @@ private:
     
     static NewRankSync*     rankSync;
     static SimTime_t        next_rankSync;
+    static GlobalReduction  rankSyncReduction;
     NewThreadSync*   threadSync;
     SimTime_t        next_threadSync;
     Exit* exit;
@@ -133,7 +195,35 @@ private:
     
     sync_type_t      next_sync_type;
 
+    /** Busy time accumulated by this thread, read by thread 0 */
+    CACHE_ALIGNED(std::atomic<uint64_t>, busy_ns);
+    std::chrono::steady_clock::time_point last_sync_end;
+    bool             running;
+
+    // Load balance checks.  Thread 0 compares the busy times and
+    // decides what to move.
+    static std::vector<SyncManager*> managers;
+    double           balance_threshold;
+    SimTime_t        balance_period;
+    SimTime_t        next_balance_check;
+    std::vector<uint64_t> balance_snapshot;
+    uint64_t         balance_checks;
+    uint64_t         balance_imbalanced;
+    uint64_t         balance_moved;
+    /** Components thread 0 decided to move at this check */
+    static std::vector<ComponentMigration*> migrations;
+
     void computeNextInsert();
+    /** Returns true if the threads were out of balance, with the busy
+     * time of each thread since the last check in busy */
+    bool checkLoadBalance(std::vector<uint64_t>& busy);
+    /** Check the balance and move Components between threads.  Called
+     * by every thread at the same sync. */
+    void balanceLoad();
+    void planMigrations(const std::vector<uint64_t>& busy);
+    void rewireComponent(ComponentMigration& migration);
+    Link* createSyncLink(LinkId_t link_id, Link* pair, ActivityQueue* queue);
+    void updateInterThreadLatencies();
     
 };
 
@@ -19,6 +19,8 @@
 #include <boost/serialization/vector.hpp>
 
 #include <sst/core/event.h>
+#include <sst/core/eventWireFormat.h>
+#include <sst/core/link.h>
 
 #include <boost/iostreams/stream_buffer.hpp>
 #include <boost/iostreams/stream.hpp>
@@ -32,7 +34,8 @@ namespace SST {
 using namespace Core::ThreadSafe;
 
 SyncQueue::SyncQueue() :
-    ActivityQueue()
+    ActivityQueue(),
+    current_buffer(0)
 {
 }
 
@@ -61,6 +64,13 @@ SyncQueue::insert(Activity* activity)
     activities.push_back(activity);
 }
 
+void
+SyncQueue::insertBatch(Activity** batch, size_t count)
+{
+    std::lock_guard<Spinlock> lock(slock);
+    activities.insert(activities.end(), batch, batch + count);
+}
+
 Activity*
 SyncQueue::pop()
 {
@@ -91,6 +101,8 @@ char*
 SyncQueue::getData()
 {
     std::lock_guard<Spinlock> lock(slock);
+    std::vector<char>& buffer = buffers[current_buffer];
+    current_buffer ^= 1;
     buffer.clear();
 
     // Reserve space for the header information
@@ -98,21 +110,41 @@ SyncQueue::getData()
         buffer.push_back(0);
     }
 
-    boost::iostreams::back_insert_device<std::vector<char> > inserter(buffer);
-    boost::iostreams::stream<boost::iostreams::back_insert_device<std::vector<char> > > output_stream(inserter);
-    boost::archive::polymorphic_binary_oarchive oa(output_stream, boost::archive::no_header || boost::archive:: no_tracking);
-
-    oa << activities;
-    output_stream.flush();
-    
+    // Registered Event types are written directly.  The rest get a
+    // marker record and go into one boost archive after all the
+    // records, so the order of the activities is kept.
+    std::vector<Activity*> fallback;
     for ( unsigned int i = 0; i < activities.size(); i++ ) {
-        delete activities[i];
+        // Once the RankSync has given the link a slot, the receiver
+        // finds the link by slot rather than by id
+        Event* ev = static_cast<Event*>(activities[i]);
+        Link* link = ev->getDeliveryLink();
+        if ( link != NULL && link->sync_slot != -1 ) ev->setDeliveryLink(link->sync_slot, link);
+
+        if ( !EventWireFormat::encode(activities[i], buffer) ) {
+            EventWireFormat::encodeFallback(buffer);
+            fallback.push_back(activities[i]);
+        }
+    }
+
+    if ( !fallback.empty() ) {
+        boost::iostreams::back_insert_device<std::vector<char> > inserter(buffer);
+        boost::iostreams::stream<boost::iostreams::back_insert_device<std::vector<char> > > output_stream(inserter);
+        boost::archive::polymorphic_binary_oarchive oa(output_stream, boost::archive::no_header | boost::archive::no_tracking);
+
+        oa << fallback;
+        output_stream.flush();
     }
-    activities.clear();
 
     SyncQueue::Header hdr;
+    hdr.count = activities.size();
     hdr.buffer_size = buffer.size();
 
+    for ( unsigned int i = 0; i < activities.size(); i++ ) {
+        delete activities[i];
+    }
+    activities.clear();
+
     char* hdr_bytes = reinterpret_cast<char*>(&hdr);
     for ( unsigned int i = 0; i < sizeof(SyncQueue::Header); i++ ) {
         buffer[i] = hdr_bytes[i];
@@ -120,6 +152,36 @@ SyncQueue::getData()
     
     return buffer.data();
  }
+
+void
+SyncQueue::extractActivities(char* buffer, std::vector<Activity*>& activities)
+{
+    SyncQueue::Header* hdr = reinterpret_cast<SyncQueue::Header*>(buffer);
+    const char* data = buffer + sizeof(SyncQueue::Header);
+    const char* end = buffer + hdr->buffer_size;
+
+    activities.clear();
+    activities.reserve(hdr->count);
+    size_t fallback_count = 0;
+    for ( uint32_t i = 0; i < hdr->count; i++ ) {
+        Activity* act = EventWireFormat::decode(data);
+        if ( act == NULL ) fallback_count++;
+        activities.push_back(act);
+    }
+    if ( fallback_count == 0 ) return;
+
+    // Fill the gaps from the boost archive at the end of the buffer
+    boost::iostreams::basic_array_source<char> source(data, end - data);
+    boost::iostreams::stream<boost::iostreams::basic_array_source <char> > input_stream(source);
+    boost::archive::polymorphic_binary_iarchive ia(input_stream, boost::archive::no_header | boost::archive::no_tracking );
+
+    std::vector<Activity*> fallback;
+    ia >> fallback;
+    size_t next = 0;
+    for ( size_t i = 0; i < activities.size(); i++ ) {
+        if ( activities[i] == NULL ) activities[i] = fallback[next++];
+    }
+}
 } // namespace SST
 
 // BOOST_CLASS_EXPORT_IMPLEMENT(SST::SyncQueue)
@@ -45,21 +45,28 @@ public:
     bool empty();
     int size();
     void insert(Activity* activity);
+    void insertBatch(Activity** batch, size_t count);
     Activity* pop(); // Not a good idea for this particular class
     Activity* front();
 
     // Not part of the ActivityQueue interface
     /** Clear elements from the queue */
     void clear();
-    /** Accessor method to the internal queue */
+    /** Accessor method to the internal queue.  Alternates between two
+     * buffers, so the data returned stays valid until the call after
+     * next and can still be in flight while the next one is filled. */
     char* getData();
+    /** Rebuild the activities in a buffer filled by getData() on the
+     * sending side, in the order they were inserted */
+    static void extractActivities(char* buffer, std::vector<Activity*>& activities);
 
     uint64_t getDataSize() {
-        return buffer.capacity() + (activities.capacity() * sizeof(Activity*));
+        return buffers[0].capacity() + buffers[1].capacity() + (activities.capacity() * sizeof(Activity*));
     }
     
 private:
-    std::vector<char> buffer;
+    std::vector<char> buffers[2];
+    int current_buffer;
     std::vector<Activity*> activities;
 
     Core::ThreadSafe::Spinlock slock;
@@ -0,0 +1,206 @@
+// Copyright 2009-2015 Sandia Corporation. Under the terms
+// of Contract DE-AC04-94AL85000 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2015, Sandia Corporation
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include "sst_config.h"
+#include "sst/core/serialization.h"
+#include "sst/core/threadSyncCMB.h"
+
+#include <thread>
+
+#include "sst/core/action.h"
+#include "sst/core/exit.h"
+#include "sst/core/output.h"
+#include "sst/core/simulation.h"
+
+namespace SST {
+
+class ThreadSyncCMB::EndAction : public Action {
+public:
+    EndAction(ThreadSyncCMB* sync) :
+        sync(sync)
+    {
+        // After everything else this thread has at the end time
+        setPriority(EXITPRIORITY);
+    }
+
+    void execute() {
+        sync->end_scheduled = false;
+        // The end time moves later if a Component took a reference
+        // and released it again while this one was scheduled
+        if ( !waitForEnd() && sync->exit->getRefCount() == 0 ) sync->scheduleEnd();
+    }
+
+    bool waitForEnd() {
+        // Nothing is sent while waiting, and if this thread has to go
+        // on it does so from now
+        SimTime_t now = Simulation::getThreadSimCycle();
+        sync->publishLowerBound(now);
+        if ( !sync->exit->waitForEnd(now) ) return false;
+        endSimulation(sync->exit->getEndTime());
+        return true;
+    }
+
+    void print(const std::string& header, Output &out) const {
+        out.output("%s ThreadSyncCMB end of simulation to be delivered at %" PRIu64 "\n", header.c_str(), getDeliveryTime());
+    }
+
+private:
+    ThreadSyncCMB* sync;
+};
+
+std::mutex ThreadSyncCMB::syncs_mutex;
+std::vector<ThreadSyncCMB*> ThreadSyncCMB::syncs;
+
+/** Create a new ThreadSyncCMB object */
+ThreadSyncCMB::ThreadSyncCMB(int num_threads, int thread, Simulation* sim) :
+    ThreadSyncDirectSkip(num_threads, thread, sim),
+    period(MAX_SIMTIME_T),
+    exit(sim->getExit()),
+    single_rank(sim->getNumRanks().rank == 1),
+    stalls(0),
+    end_scheduled(false),
+    lower_bound(0)
+{
+    end_action = new EndAction(this);
+
+    // The ThreadSyncs are created by all the threads at once
+    std::lock_guard<std::mutex> lock(syncs_mutex);
+    if ( syncs.size() < (size_t)num_threads ) syncs.resize(num_threads, NULL);
+    syncs[thread] = this;
+}
+
+ThreadSyncCMB::~ThreadSyncCMB()
+{
+    // Otherwise it is deleted with the TimeVortex
+    if ( !end_scheduled ) delete end_action;
+    if ( stalls > 0 )
+        Output::getDefaultObject().verbose(CALL_INFO, 1, 0, "ThreadSyncCMB thread %d stalled at %" PRIu64 " syncs.\n", thread, stalls);
+}
+
+void
+ThreadSyncCMB::finalizeLinkConfigurations()
+{
+    ThreadSyncDirectSkip::finalizeLinkConfigurations();
+
+    // Only the threads there are links from need to be watched, each
+    // with the latency of its own links to this thread.  All
+    // threads have finished wireup, so every ThreadSync is registered.
+    for ( int i = 0; i < num_threads; i++ ) {
+        SimTime_t latency = sim->getInterThreadLatency(i, thread);
+        if ( i == thread || latency == MAX_SIMTIME_T ) continue;
+        Channel channel;
+        channel.sender = syncs[i];
+        channel.latency = latency;
+        inputs.push_back(channel);
+        if ( latency < period ) period = latency;
+    }
+
+    if ( inputs.empty() ) period = sim->getMinInterThreadLatency();
+}
+
+SimTime_t
+ThreadSyncCMB::getHorizon() const
+{
+    SimTime_t horizon = MAX_SIMTIME_T;
+    for ( size_t i = 0; i < inputs.size(); i++ ) {
+        SimTime_t bound = inputs[i].sender->lower_bound.load(std::memory_order_acquire);
+        if ( bound >= MAX_SIMTIME_T - inputs[i].latency ) continue;
+        if ( bound + inputs[i].latency < horizon ) horizon = bound + inputs[i].latency;
+    }
+    return horizon;
+}
+
+void
+ThreadSyncCMB::publishLowerBound(SimTime_t time)
+{
+    // Only this thread writes its bound, and it never moves backwards
+    // while other threads are running
+    if ( time > lower_bound.load(std::memory_order_relaxed) ) {
+        lower_bound.store(time, std::memory_order_release);
+    }
+}
+
+void
+ThreadSyncCMB::after()
+{
+    // Called at a rank sync, where all threads are at the same time.
+    // Events from other ranks may have just been delivered, so the
+    // bound has to go back to the current time before anyone
+    // computes a new horizon.
+    SimTime_t now = sim->getCurrentSimCycle();
+    lower_bound.store(now, std::memory_order_release);
+    totalWaitTime += barrier.wait();
+
+    SimTime_t horizon = getHorizon();
+    SimTime_t next = sim->getNextActivityTime();
+    publishLowerBound(next < horizon ? next : horizon);
+
+    if ( period != MAX_SIMTIME_T && now + period < horizon ) horizon = now + period;
+    nextSyncTime = horizon;
+}
+
+void
+ThreadSyncCMB::execute()
+{
+    SimTime_t now = sim->getCurrentSimCycle();
+    SimTime_t horizon;
+    unsigned int spins = 0;
+    while ( true ) {
+        // Everything an input sent before publishing the bound read
+        // here is in the queues, and anything it sends later arrives
+        // at or after the horizon
+        horizon = getHorizon();
+        before();
+
+        // Nothing will be sent by this thread before its next
+        // activity, and nothing new can arrive before the horizon
+        SimTime_t next = sim->getNextActivityTime();
+        publishLowerBound(next < horizon ? next : horizon);
+
+        if ( horizon > now ) break;
+        // The inputs may be waiting at the end time for this thread,
+        // which is already there
+        if ( single_rank && exit->getRefCount() == 0 && waitForEnd() ) return;
+
+        if ( spins == 0 ) stalls++;
+        if ( ++spins < 1000 ) _mm_pause();
+        else std::this_thread::yield();
+    }
+
+    if ( period != MAX_SIMTIME_T && now + period < horizon ) horizon = now + period;
+    nextSyncTime = horizon;
+
+    if ( single_rank && exit->getRefCount() == 0 ) scheduleEnd();
+}
+
+void
+ThreadSyncCMB::scheduleEnd()
+{
+    if ( end_scheduled ) return;
+    SimTime_t time = exit->getEndTime();
+    SimTime_t now = sim->getCurrentSimCycle();
+    if ( time < now ) time = now;
+    // This thread has nothing to do before its bound, so stopping
+    // there instead skips nothing and keeps the bound true if it has
+    // to go on
+    SimTime_t bound = lower_bound.load(std::memory_order_relaxed);
+    if ( bound != MAX_SIMTIME_T && time < bound ) time = bound;
+    sim->insertActivity(time, end_action);
+    end_scheduled = true;
+}
+
+bool
+ThreadSyncCMB::waitForEnd()
+{
+    return end_action->waitForEnd();
+}
+
+} // namespace SST
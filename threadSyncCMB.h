@@ -0,0 +1,101 @@
+// Copyright 2009-2015 Sandia Corporation. Under the terms
+// of Contract DE-AC04-94AL85000 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2015, Sandia Corporation
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef SST_CORE_THREADSYNCCMB_H
+#define SST_CORE_THREADSYNCCMB_H
+
+#include "sst/core/sst_types.h"
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "sst/core/threadSyncDirectSkip.h"
+
+namespace SST {
+
+class Exit;
+class Simulation;
+
+/** Conservative (Chandy-Misra-Bryant style) ThreadSync.  Each thread
+ * publishes a lower bound on the time of anything it can still send.
+ * A thread can safely run up to the smallest published bound plus
+ * link latency over the threads it receives from, and only ever waits
+ * on those threads.  Events are exchanged through the same SPSC
+ * queues as ThreadSyncDirectSkip, so no barriers are needed between
+ * threads except at rank syncs.
+ */
+class ThreadSyncCMB : public ThreadSyncDirectSkip {
+public:
+    /** Create a new ThreadSync object */
+    ThreadSyncCMB(int num_threads, int thread, Simulation* sim);
+    ~ThreadSyncCMB();
+
+    /** lower_bound is CACHE_ALIGNED, which plain new does not honour */
+    static void* operator new(size_t size) { return Core::ThreadSafe::allocCacheAligned(size); }
+    static void operator delete(void* ptr) { free(ptr); }
+
+    void after();
+    void execute(void);
+
+    /** Finish link configuration */
+    void finalizeLinkConfigurations();
+
+    void publishLowerBound(SimTime_t time);
+
+    bool handlesEnd() const { return single_rank; }
+
+private:
+    class EndAction;
+
+    /** A thread this one receives events from */
+    struct Channel {
+        ThreadSyncCMB* sender;
+        SimTime_t latency;
+    };
+
+    std::vector<Channel> inputs;
+    /** Longest time between two syncs (the shortest input latency),
+     * so that every thread keeps checking for the end of simulation */
+    SimTime_t period;
+    Exit* exit;
+    bool single_rank;
+    /** Number of times no progress could be made at a sync */
+    uint64_t stalls;
+    /** Stops this thread at the end time once no Component holds the
+     * simulation open (single rank only) */
+    EndAction* end_action;
+    bool end_scheduled;
+
+    /** No event sent by this thread from now on will have a send time
+     * earlier than this */
+    CACHE_ALIGNED(std::atomic<SimTime_t>, lower_bound);
+
+    static std::mutex syncs_mutex;
+    static std::vector<ThreadSyncCMB*> syncs;
+
+    /** Time up to which all events from the input threads are known */
+    SimTime_t getHorizon() const;
+
+    /** Have this thread stop at the end time, which is the latest
+     * time any thread's Components released the simulation.  Threads
+     * are at different times, so each one has to run up to it on its
+     * own before the simulation can end. */
+    void scheduleEnd();
+    /** Wait for the other threads at the end time.  Returns true if
+     * the simulation has ended. */
+    bool waitForEnd();
+};
+
+
+} // namespace SST
+
+#endif // SST_CORE_THREADSYNCCMB_H
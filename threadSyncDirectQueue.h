@@ -0,0 +1,160 @@
+// Copyright 2009-2015 Sandia Corporation. Under the terms
+// of Contract DE-AC04-94AL85000 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2015, Sandia Corporation
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef SST_CORE_THREADSYNCDIRECTQUEUE_H
+#define SST_CORE_THREADSYNCDIRECTQUEUE_H
+
+#include <sst/core/serialization.h>
+
+#include <atomic>
+
+#include <sst/core/activityQueue.h>
+#include <sst/core/threadsafe.h>
+
+namespace SST {
+
+class ThreadSyncDirectSkip;
+
+/** Lock-free single producer, single consumer queue carrying the
+ * events sent from one thread to another.  The sending thread is the
+ * only one that inserts and the receiving thread (the owner) is the
+ * only one that pops.  Storage is a list of fixed size chunks so the
+ * queue never has to be resized while the other side is using it.
+ */
+class ThreadSyncDirectQueue : public ActivityQueue {
+public:
+    ThreadSyncDirectQueue(ThreadSyncDirectSkip* owner) :
+        ActivityQueue(),
+        owner(owner),
+        write_count(0),
+        spare(NULL),
+        read_count(0),
+        read_limit(0)
+    {
+        tail_chunk = head_chunk = new Chunk();
+        tail_pos = head_pos = 0;
+    }
+
+    /** The counters are CACHE_ALIGNED, which plain new does not honour */
+    static void* operator new(size_t size) { return Core::ThreadSafe::allocCacheAligned(size); }
+    static void operator delete(void* ptr) { free(ptr); }
+
+    ~ThreadSyncDirectQueue() {
+        while ( head_chunk != NULL ) {
+            Chunk* next = head_chunk->next.load(std::memory_order_relaxed);
+            delete head_chunk;
+            head_chunk = next;
+        }
+        delete spare.load(std::memory_order_relaxed);
+    }
+
+    /** Returns true if the queue is empty (receiving thread only) */
+    bool empty() {
+        return !available();
+    }
+
+    /** Returns the number of activities in the queue */
+    int size() {
+        return write_count.load(std::memory_order_acquire) - read_count;
+    }
+
+    /** Remove and return the next activity, or NULL if there is none
+     * (receiving thread only) */
+    Activity* pop() {
+        if ( !available() ) return NULL;
+        if ( head_pos == CHUNK_SIZE ) nextChunk();
+        read_count++;
+        return head_chunk->slots[head_pos++];
+    }
+
+    /** Insert a new activity into the queue (sending thread only) */
+    void insert(Activity* activity) {
+        put(activity);
+        write_count.store(write_count.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    /** Insert a batch of activities, published together (sending
+     * thread only) */
+    void insertBatch(Activity** batch, size_t count) {
+        for ( size_t i = 0; i < count; i++ ) put(batch[i]);
+        write_count.store(write_count.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
+    /** Returns the next activity without removing it (receiving
+     * thread only) */
+    Activity* front() {
+        if ( !available() ) return NULL;
+        if ( head_pos == CHUNK_SIZE ) nextChunk();
+        return head_chunk->slots[head_pos];
+    }
+
+    /** Returns the ThreadSync of the receiving thread */
+    ThreadSyncDirectSkip* getOwner() const { return owner; }
+
+private:
+    static const unsigned int CHUNK_SIZE = 256;
+
+    struct Chunk {
+        Chunk() : next(NULL) {}
+        Activity* slots[CHUNK_SIZE];
+        std::atomic<Chunk*> next;
+    };
+
+    ThreadSyncDirectSkip* owner;
+
+    // Sending side
+    CACHE_ALIGNED(std::atomic<size_t>, write_count);
+    Chunk* tail_chunk;
+    unsigned int tail_pos;
+    /** One drained chunk handed back from the receiving side so the
+     * steady state does not allocate */
+    CACHE_ALIGNED(std::atomic<Chunk*>, spare);
+
+    // Receiving side
+    CACHE_ALIGNED(size_t, read_count);
+    size_t read_limit;
+    Chunk* head_chunk;
+    unsigned int head_pos;
+
+    inline bool available() {
+        if ( read_count != read_limit ) return true;
+        // Only go to the shared counter once everything we already
+        // know about has been consumed
+        read_limit = write_count.load(std::memory_order_acquire);
+        return read_count != read_limit;
+    }
+
+    inline void put(Activity* activity) {
+        if ( tail_pos == CHUNK_SIZE ) {
+            Chunk* chunk = spare.exchange(NULL, std::memory_order_acquire);
+            if ( chunk == NULL ) chunk = new Chunk();
+            else chunk->next.store(NULL, std::memory_order_relaxed);
+            // Made visible to the receiver by the release store of
+            // write_count
+            tail_chunk->next.store(chunk, std::memory_order_relaxed);
+            tail_chunk = chunk;
+            tail_pos = 0;
+        }
+        tail_chunk->slots[tail_pos++] = activity;
+    }
+
+    inline void nextChunk() {
+        Chunk* done = head_chunk;
+        head_chunk = done->next.load(std::memory_order_relaxed);
+        head_pos = 0;
+        delete spare.exchange(done, std::memory_order_release);
+    }
+};
+
+} //namespace SST
+
+#endif // SST_CORE_THREADSYNCDIRECTQUEUE_H
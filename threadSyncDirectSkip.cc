@@ -0,0 +1,91 @@
+// Copyright 2009-2015 Sandia Corporation. Under the terms
+// of Contract DE-AC04-94AL85000 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2015, Sandia Corporation
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include "sst_config.h"
+#include "sst/core/serialization.h"
+#include "sst/core/threadSyncDirectSkip.h"
+
+#include "sst/core/event.h"
+#include "sst/core/link.h"
+#include "sst/core/output.h"
+#include "sst/core/simulation.h"
+
+namespace SST {
+
+/** Create a new ThreadSyncDirectSkip object */
+ThreadSyncDirectSkip::ThreadSyncDirectSkip(int num_threads, int thread, Simulation* sim) :
+    ThreadSyncSkipBase(num_threads, thread, sim)
+{
+    for ( int i = 0; i < num_threads; i++ ) {
+        queues.push_back(new ThreadSyncDirectQueue(this));
+    }
+}
+
+ThreadSyncDirectSkip::~ThreadSyncDirectSkip()
+{
+    if ( totalWaitTime > 0.0 )
+        Output::getDefaultObject().verbose(CALL_INFO, 1, 0, "ThreadSyncDirectSkip total wait time: %lg seconds.\n", totalWaitTime);
+    for ( int i = 0; i < num_threads; i++ ) {
+        delete queues[i];
+    }
+    queues.clear();
+}
+
+ActivityQueue*
+ThreadSyncDirectSkip::getQueueForThread(int tid)
+{
+    return queues[tid];
+}
+
+void
+ThreadSyncDirectSkip::before()
+{
+    // No need to barrier.  SyncManger already barriers before calling
+    // this function
+    for ( int i = 0; i < num_threads; i++ ) {
+        ThreadSyncDirectQueue* queue = queues[i];
+        Activity* activity;
+        while ( (activity = queue->pop()) != NULL ) {
+            deliver(static_cast<Event*>(activity));
+        }
+    }
+}
+
+void
+ThreadSyncDirectSkip::processLinkInitData()
+{
+    // Init data is not on the critical path, so it still goes through
+    // the link map
+    for ( int i = 0; i < num_threads; i++ ) {
+        ThreadSyncDirectQueue* queue = queues[i];
+        Activity* activity;
+        while ( (activity = queue->pop()) != NULL ) {
+            Event* ev = static_cast<Event*>(activity);
+            auto link = link_map.find(ev->getLinkId());
+            if (link == link_map.end()) {
+                sim->getSimulationOutput().fatal(CALL_INFO, 1, "Link not found in map!\n");
+            } else {
+                sendInitData_sync(link->second,ev);
+            }
+        }
+    }
+}
+
+ThreadSyncSkipBase*
+ThreadSyncDirectSkip::getReceivingSync(LinkId_t link_id, Link* link)
+{
+    // The sync side Link on this thread sends into a queue owned by
+    // the receiving thread
+    ThreadSyncDirectQueue* queue = static_cast<ThreadSyncDirectQueue*>(link->recvQueue);
+    return queue->getOwner();
+}
+
+} // namespace SST
@@ -0,0 +1,59 @@
+// Copyright 2009-2015 Sandia Corporation. Under the terms
+// of Contract DE-AC04-94AL85000 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2015, Sandia Corporation
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef SST_CORE_THREADSYNCDIRECTSKIP_H
+#define SST_CORE_THREADSYNCDIRECTSKIP_H
+
+#include "sst/core/sst_types.h"
+#include <sst/core/serialization.h>
+
+#include <vector>
+
+#include "sst/core/threadSyncSkipBase.h"
+#include "sst/core/threadSyncDirectQueue.h"
+
+namespace SST {
+
+class ActivityQueue;
+class Link;
+class Simulation;
+
+/** ThreadSync that exchanges events through a lock-free SPSC queue
+ * for each ordered pair of threads instead of the locked vectors of
+ * ThreadSyncSimpleSkip.  Events are delivered the same way, so the
+ * difference is only the transport.  The queues can be drained while
+ * the sending thread is still running, which is what ThreadSyncCMB
+ * is built on.
+ */
+class ThreadSyncDirectSkip : public ThreadSyncSkipBase {
+public:
+    /** Create a new ThreadSync object */
+    ThreadSyncDirectSkip(int num_threads, int thread, Simulation* sim);
+    ~ThreadSyncDirectSkip();
+
+    void before();
+
+    /** Cause an exchange of Initialization Data to occur */
+    void processLinkInitData();
+
+    ActivityQueue* getQueueForThread(int tid);
+
+protected:
+    /** Incoming queues, indexed by sending thread */
+    std::vector<ThreadSyncDirectQueue*> queues;
+
+    ThreadSyncSkipBase* getReceivingSync(LinkId_t link_id, Link* link);
+};
+
+
+} // namespace SST
+
+#endif // SST_CORE_THREADSYNCDIRECTSKIP_H
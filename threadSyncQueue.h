@@ -48,6 +48,11 @@ public:
     void insert(Activity* activity) {
         activities.push_back(activity);
     }
+
+    /** Insert a batch of activities */
+    void insertBatch(Activity** batch, size_t count) {
+        activities.insert(activities.end(), batch, batch + count);
+    }
     
     /** Not supported */
     Activity* front() {
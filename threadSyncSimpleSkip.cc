@@ -23,33 +23,24 @@
 namespace SST {
 
 SimTime_t ThreadSyncSimpleSkip::localMinimumNextActivityTime = 0;
+std::mutex ThreadSyncSimpleSkip::syncs_mutex;
+std::vector<ThreadSyncSimpleSkip*> ThreadSyncSimpleSkip::syncs;
 
 /** Create a new ThreadSyncSimpleSkip object */
 ThreadSyncSimpleSkip::ThreadSyncSimpleSkip(int num_threads, int thread, Simulation* sim) :
-    NewThreadSync(),
-    num_threads(num_threads),
-    thread(thread),
-    sim(sim),
-    totalWaitTime(0.0)
+    ThreadSyncSkipBase(num_threads, thread, sim)
 {
     // TraceFunction trace(CALL_INFO_LONG);
     for ( int i = 0; i < num_threads; i++ ) {
         queues.push_back(new ThreadSyncQueue());
     }
 
-    if ( sim->getRank().thread == 0 )
-        barrier.resize(num_threads);
-
     if ( sim->getNumRanks().rank > 1 ) single_rank = false;
     else single_rank = true;
 
-    const std::vector<SimTime_t>& vec = sim->getInterThreadLatencies();
-    SimTime_t min = vec[0];
-    for ( int i = 1; i < vec.size(); i++ ) {
-        if ( vec[i] < min ) min = vec[i];
-    }
-    max_period = min;
-    nextSyncTime = max_period;
+    std::lock_guard<std::mutex> lock(syncs_mutex);
+    if ( syncs.size() < (size_t)num_threads ) syncs.resize(num_threads, NULL);
+    syncs[thread] = this;
 }
 
 ThreadSyncSimpleSkip::~ThreadSyncSimpleSkip()
@@ -72,13 +63,6 @@ ThreadSyncSimpleSkip::~ThreadSyncSimpleSkip()
 //     sim->insertActivity( next, this );
 // }
 
-void
-ThreadSyncSimpleSkip::registerLink(LinkId_t link_id, Link* link)
-{
-    // TraceFunction trace(CALL_INFO_LONG);
-    link_map[link_id] = link;
-}
-
 ActivityQueue*
 ThreadSyncSimpleSkip::getQueueForThread(int tid)
 {
@@ -103,15 +87,7 @@ ThreadSyncSimpleSkip::before()
         ThreadSyncQueue* queue = queues[i];
         std::vector<Activity*>& vec = queue->getVector();
         for ( int j = 0; j < vec.size(); j++ ) {
-            Event* ev = static_cast<Event*>(vec[j]);
-            auto link = link_map.find(ev->getLinkId());
-            if (link == link_map.end()) {
-                printf("Link not found in map!\n");
-                abort();
-            } else {
-                SimTime_t delay = ev->getDeliveryTime() - sim->getCurrentSimCycle();
-                link->second->send(delay,ev);
-            }
+            deliver(static_cast<Event*>(vec[j]));
         }
         queue->clear();
     }
@@ -123,77 +99,6 @@ ThreadSyncSimpleSkip::before()
 
 }
 
-void
-ThreadSyncSimpleSkip::after()
-{
-    // TraceFunction trace(CALL_INFO_LONG);
-
-    // Use this nextSyncTime computation for no skip
-    // nextSyncTime = sim->getCurrentSimCycle() + max_period;
-    
-    
-    // No need to barrier.  SyncManger already barriers before calling
-    // this function
-
-    // totalWaitTime += barrier.wait();
-
-
-    // Use this nextSyncTime computation for skipping
-
-    // if ( thread == 0 ) localMinimumNextActivityTime = sim->getLocalMinimumNextActivityTime();
-    // totalWaitTime += barrier.wait();
-    // nextSyncTime = localMinimumNextActivityTime + max_period;
-    nextSyncTime = sim->getLocalMinimumNextActivityTime() + max_period;
-    totalWaitTime += barrier.wait();
-
-}
-
-void
-ThreadSyncSimpleSkip::execute()
-{
-    // TraceFunction trace(CALL_INFO_LONG);
-
-    totalWaitTime = barrier.wait();
-    before();
-    totalWaitTime = barrier.wait();
-    after();
-    
-
-    // // TraceFunction trace(CALL_INFO_LONG);
-    // totalWaitTime += barrier.wait();
-    // // if ( disabled ) return;
-    // // Empty all the queues and send events on the links
-    // for ( int i = 0; i < queues.size(); i++ ) {
-    //     ThreadSyncQueue* queue = queues[i];
-    //     std::vector<Activity*>& vec = queue->getVector();
-    //     for ( int j = 0; j < vec.size(); j++ ) {
-    //         Event* ev = static_cast<Event*>(vec[j]);
-    //         auto link = link_map.find(ev->getLinkId());
-    //         if (link == link_map.end()) {
-    //             printf("Link not found in map!\n");
-    //             abort();
-    //         } else {
-    //             SimTime_t delay = ev->getDeliveryTime() - sim->getCurrentSimCycle();
-    //             link->second->send(delay,ev);
-    //         }
-    //     }
-    //     queue->clear();
-    // }
-
-    // // Use this nextSyncTime computation for no skip
-    // // nextSyncTime = sim->getCurrentSimCycle() + max_period;
-
-
-    // // Use this nextSyncTime computation for skipping
-    // totalWaitTime += barrier.wait();
-
-    // // if ( thread == 0 ) localMinimumNextActivityTime = sim->getLocalMinimumNextActivityTime();
-    // // totalWaitTime += barrier.wait();
-    // // nextSyncTime = localMinimumNextActivityTime + max_period;
-    // nextSyncTime = sim->getLocalMinimumNextActivityTime() + max_period;
-    
-}
-
 void
 ThreadSyncSimpleSkip::processLinkInitData()
 {
@@ -218,23 +123,24 @@ ThreadSyncSimpleSkip::processLinkInitData()
     }
 }
 
-void
-ThreadSyncSimpleSkip::finalizeLinkConfigurations() {
-    // TraceFunction trace(CALL_INFO_LONG);
-    for (auto i = link_map.begin() ; i != link_map.end() ; ++i) {
-        // i->second->finalizeConfiguration();
-        finalizeConfiguration(i->second);
+ThreadSyncSkipBase*
+ThreadSyncSimpleSkip::getReceivingSync(LinkId_t link_id, Link* link)
+{
+    // The sync side Link on this thread sends into a queue owned by
+    // the receiving thread
+    ThreadSyncSimpleSkip* remote = NULL;
+    for ( size_t t = 0; t < syncs.size(); t++ ) {
+        if ( syncs[t]->queues[thread] == link->recvQueue ) {
+            remote = syncs[t];
+            break;
+        }
     }
+    if ( remote == NULL ) {
+        sim->getSimulationOutput().fatal(CALL_INFO, 1, "Link %ld does not send to another thread\n", link_id);
+    }
+    return remote;
 }
 
-uint64_t
-ThreadSyncSimpleSkip::getDataSize() const {
-    // TraceFunction trace(CALL_INFO_LONG);
-    size_t count = 0;
-    return count;
-}
-
-
 // void
 // ThreadSyncSimpleSkip::print(const std::string& header, Output &out) const
 // {
@@ -245,6 +151,5 @@ ThreadSyncSimpleSkip::getDataSize() const {
 
 
 // bool ThreadSyncSimpleSkip::disabled = false;
-Core::ThreadSafe::Barrier ThreadSyncSimpleSkip::barrier;
 
 } // namespace SST
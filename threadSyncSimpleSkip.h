@@ -15,11 +15,13 @@
 #include "sst/core/sst_types.h"
 #include <sst/core/serialization.h>
 
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 
 #include "sst/core/action.h"
-#include "sst/core/syncManager.h"
 #include "sst/core/threadSyncQueue.h"
+#include "sst/core/threadSyncSkipBase.h"
 
 namespace SST {
 
@@ -31,7 +33,7 @@ class Event;
 class Simulation;
 class ThreadSyncQueue;
 
-class ThreadSyncSimpleSkip : public NewThreadSync {
+class ThreadSyncSimpleSkip : public ThreadSyncSkipBase {
 public:
     /** Create a new ThreadSync object */
     ThreadSyncSimpleSkip(int num_threads, int thread, Simulation* sim);
@@ -40,34 +42,25 @@ public:
     void setMaxPeriod(TimeConverter* period);
     
     void before();
-    void after();
-    void execute(void);
 
     /** Cause an exchange of Initialization Data to occur */
     void processLinkInitData();
-    /** Finish link configuration */
-    void finalizeLinkConfigurations();
 
-    /** Register a Link which this Sync Object is responsible for */
-    void registerLink(LinkId_t link_id, Link* link);
     ActivityQueue* getQueueForThread(int tid);
 
-    uint64_t getDataSize() const;
-
     // static void disable() { disabled = true; barrier.disable(); }
 
+protected:
+    ThreadSyncSkipBase* getReceivingSync(LinkId_t link_id, Link* link);
+
 private:
     std::vector<ThreadSyncQueue*> queues;
-    std::unordered_map<LinkId_t, Link*> link_map;
-    SimTime_t max_period;
-    int num_threads;
-    int thread;
     static SimTime_t localMinimumNextActivityTime;
-    Simulation* sim;
     // static bool disabled;
-    static Core::ThreadSafe::Barrier barrier;
-    double totalWaitTime;
     bool single_rank;
+
+    static std::mutex syncs_mutex;
+    static std::vector<ThreadSyncSimpleSkip*> syncs;
 };
 
 
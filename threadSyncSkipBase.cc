@@ -0,0 +1,137 @@
+// Copyright 2009-2015 Sandia Corporation. Under the terms
+// of Contract DE-AC04-94AL85000 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2015, Sandia Corporation
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include "sst_config.h"
+#include "sst/core/serialization.h"
+#include "sst/core/threadSyncSkipBase.h"
+
+#include "sst/core/event.h"
+#include "sst/core/link.h"
+#include "sst/core/output.h"
+#include "sst/core/simulation.h"
+
+namespace SST {
+
+ThreadSyncSkipBase::ThreadSyncSkipBase(int num_threads, int thread, Simulation* sim) :
+    NewThreadSync(),
+    num_threads(num_threads),
+    thread(thread),
+    sim(sim),
+    totalWaitTime(0.0)
+{
+    if ( sim->getRank().thread == 0 )
+        barrier.resize(num_threads);
+
+    // All threads have to agree on the first sync, so start with the
+    // smallest latency between any two threads
+    max_period = sim->getMinInterThreadLatency();
+    nextSyncTime = max_period;
+}
+
+void
+ThreadSyncSkipBase::registerLink(LinkId_t link_id, Link* link)
+{
+    link_map[link_id] = link;
+}
+
+Link*
+ThreadSyncSkipBase::getRegisteredLink(LinkId_t link_id)
+{
+    auto link = link_map.find(link_id);
+    if ( link == link_map.end() ) return NULL;
+    return link->second;
+}
+
+void
+ThreadSyncSkipBase::unregisterLink(LinkId_t link_id)
+{
+    link_map.erase(link_id);
+}
+
+void
+ThreadSyncSkipBase::updateLinks()
+{
+    // Components have moved between threads, so the lookahead and
+    // the Links on the receiving threads may have changed.  If no
+    // links cross threads anymore, keep syncing at the old period so
+    // the end of simulation is still noticed.
+    if ( sim->getMinInterThreadLatency() != MAX_SIMTIME_T ) {
+        max_period = sim->getMinInterThreadLatency();
+    }
+    for (auto i = link_map.begin() ; i != link_map.end() ; ++i) {
+        setSyncTarget(i->first, i->second);
+    }
+}
+
+void
+ThreadSyncSkipBase::finalizeLinkConfigurations() {
+    for (auto i = link_map.begin() ; i != link_map.end() ; ++i) {
+        finalizeConfiguration(i->second);
+        setSyncTarget(i->first, i->second);
+    }
+}
+
+void
+ThreadSyncSkipBase::setSyncTarget(LinkId_t link_id, Link* link)
+{
+    // Point straight at the Link that delivers the events on the
+    // receiving thread so they do not have to be looked up by id.
+    // Only called once all threads have finished wiring, so the
+    // receiving thread's map is no longer changing.
+    ThreadSyncSkipBase* remote = getReceivingSync(link_id, link);
+    auto remote_link = remote->link_map.find(link_id);
+    if ( remote_link == remote->link_map.end() ) {
+        sim->getSimulationOutput().fatal(CALL_INFO, 1, "Link %ld not registered with the receiving thread\n", link_id);
+    }
+    link->sync_target = remote_link->second;
+}
+
+void
+ThreadSyncSkipBase::deliver(Event* ev)
+{
+    Link* target = ev->getDeliveryLink()->sync_target;
+    SimTime_t delay = ev->getDeliveryTime() - sim->getCurrentSimCycle();
+    target->send(delay,ev);
+}
+
+void
+ThreadSyncSkipBase::after()
+{
+    // The next sync only has to come before the first event that can
+    // reach another thread, which depends on when each thread next
+    // has something to do and on the latencies of its own links
+    nextSyncTime = sim->getLocalMinimumInterThreadDeliveryTime();
+    if ( nextSyncTime == MAX_SIMTIME_T && max_period != MAX_SIMTIME_T ) {
+        // Keep syncing so the end of simulation is noticed
+        nextSyncTime = sim->getLocalMinimumNextActivityTime() + max_period;
+    }
+    totalWaitTime += barrier.wait();
+}
+
+void
+ThreadSyncSkipBase::execute()
+{
+    totalWaitTime += barrier.wait();
+    before();
+    totalWaitTime += barrier.wait();
+    after();
+}
+
+uint64_t
+ThreadSyncSkipBase::getDataSize() const {
+    size_t count = 0;
+    return count;
+}
+
+
+Core::ThreadSafe::Barrier ThreadSyncSkipBase::barrier;
+
+} // namespace SST
@@ -0,0 +1,84 @@
+// Copyright 2009-2015 Sandia Corporation. Under the terms
+// of Contract DE-AC04-94AL85000 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2015, Sandia Corporation
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef SST_CORE_THREADSYNCSKIPBASE_H
+#define SST_CORE_THREADSYNCSKIPBASE_H
+
+#include "sst/core/sst_types.h"
+#include <sst/core/serialization.h>
+
+#include <unordered_map>
+
+#include "sst/core/syncManager.h"
+
+namespace SST {
+
+class Event;
+class Link;
+class Simulation;
+
+/** Parts shared by the ThreadSyncs that skip ahead to the next time
+ * an event can cross threads.  Keeps the sync side Links, points each
+ * one at the sync side Link on the receiving thread, delivers events
+ * from other threads on that Link and computes the next sync time.
+ * Subclasses provide the queues events are exchanged through.
+ */
+class ThreadSyncSkipBase : public NewThreadSync {
+public:
+    ThreadSyncSkipBase(int num_threads, int thread, Simulation* sim);
+    virtual ~ThreadSyncSkipBase() {}
+
+    void after();
+    void execute(void);
+
+    /** Finish link configuration */
+    void finalizeLinkConfigurations();
+
+    /** Register a Link which this Sync Object is responsible for */
+    void registerLink(LinkId_t link_id, Link* link);
+
+    bool canMoveComponents() const { return true; }
+    Link* getRegisteredLink(LinkId_t link_id);
+    void unregisterLink(LinkId_t link_id);
+    void updateLinks();
+
+    uint64_t getDataSize() const;
+
+protected:
+    /** Sync side Links on this thread, by id */
+    std::unordered_map<LinkId_t, Link*> link_map;
+    /** Smallest latency between two threads */
+    SimTime_t max_period;
+    int num_threads;
+    int thread;
+    Simulation* sim;
+    static Core::ThreadSafe::Barrier barrier;
+    double totalWaitTime;
+
+    /** Return the ThreadSync of the thread a sync side Link on this
+     * thread sends to */
+    virtual ThreadSyncSkipBase* getReceivingSync(LinkId_t link_id, Link* link) = 0;
+
+    /** Deliver an event received from another thread.  The event
+     * still points at the sync side Link on the sending thread, which
+     * knows the sync side Link on this thread for the same id.
+     * Sending on that Link adds its latency, which holds the receive
+     * latency of the Component at this end. */
+    void deliver(Event* ev);
+
+private:
+    void setSyncTarget(LinkId_t link_id, Link* link);
+};
+
+
+} // namespace SST
+
+#endif // SST_CORE_THREADSYNCSKIPBASE_H
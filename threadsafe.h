@@ -16,14 +16,27 @@
 
 #include <thread>
 #include <atomic>
+#include <chrono>
+#include <climits>
 #include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <mutex>
+#include <new>
 
 #include <vector>
 //#include <stdalign.h>
 
 #include <sched.h>
 
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 #include <sst/core/profile.h>
 
 namespace SST {
@@ -40,54 +53,266 @@ namespace ThreadSafe {
 #  endif
 #endif
 
+/** Allocate size bytes starting on a cache line.  Plain new does not
+ * honour the alignment of CACHE_ALIGNED members before C++17.  Release
+ * with free(). */
+inline void* allocCacheAligned(size_t size)
+{
+    void* ptr = NULL;
+    int ret = posix_memalign(&ptr, 64, size);
+    if ( ret != 0 ) {
+        fprintf(stderr, "Failed to allocate %zu cache aligned bytes.  Error: %s\n", size, strerror(ret));
+        abort();
+    }
+    return ptr;
+}
+
+/** Number of waits and time spent waiting in Barrier::wait() by one
+ * thread.  Only the owning thread updates these, other threads may
+ * read them (e.g. for the heartbeat). */
+struct BarrierWaitStats {
+    std::atomic<uint64_t> count;
+    std::atomic<uint64_t> nanoseconds;
+
+    BarrierWaitStats() : count(0), nanoseconds(0)
+    { }
+};
+
 class Barrier {
+public:
+    /** Barrier algorithms */
+    typedef enum {
+        CENTRAL,        /*!< One shared counter */
+        DISSEMINATION   /*!< log2(n) rounds of pairwise signals */
+    } Type_t;
+
+private:
+    /** Number of pause loops before a waiting thread goes to sleep */
+    static const unsigned int SPIN_COUNT = 4096;
+
+    /** Signal received by one thread in one round of the
+     * dissemination barrier.  Each has its own cache line and is only
+     * written by one other thread. */
+    struct Flag {
+        CACHE_ALIGNED(std::atomic<uint32_t>, epoch);
+        std::atomic<uint32_t> sleeping;
+        Flag() : epoch(0), sleeping(0) {}
+    };
+    /** Number of times each thread has passed the barrier */
+    struct Epoch {
+        CACHE_ALIGNED(uint32_t, count);
+        Epoch() : count(0) {}
+    };
+
     std::mutex mtx;
     std::condition_variable cv;
     size_t origCount;
     std::atomic<bool> enabled;
-    std::atomic<size_t> count, generation;
+    std::atomic<size_t> count;
+    /* 32 bits so it can be used as a futex */
+    std::atomic<uint32_t> generation;
+    /* Threads that stopped spinning and are asleep */
+    std::atomic<uint32_t> sleepers;
+
+    Type_t type;
+    unsigned int rounds;
+    Flag* flags;
+    Epoch* epochs;
+
+    static Type_t& defaultType()
+    {
+        static Type_t type = CENTRAL;
+        return type;
+    }
+
+    static uint32_t& threadIndex()
+    {
+        static thread_local uint32_t index = 0;
+        return index;
+    }
+
+    static void futexWait(std::atomic<uint32_t>* addr, uint32_t value)
+    {
+#ifdef __linux__
+        // Returns right away if the value has already changed
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(addr), FUTEX_WAIT_PRIVATE, value, NULL, NULL, 0);
+#else
+        std::this_thread::yield();
+#endif
+    }
+
+    static void futexWake(std::atomic<uint32_t>* addr)
+    {
+#ifdef __linux__
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(addr), FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+#endif
+    }
+
+    void sleep(uint32_t gen)
+    {
+        ++sleepers;
+#ifdef __linux__
+        while ( gen == generation.load() ) {
+            futexWait(&generation, gen);
+        }
+#else
+        std::unique_lock<std::mutex> lock(mtx);
+        while ( gen == generation.load() ) cv.wait(lock);
+#endif
+        --sleepers;
+    }
+
+    void wakeAll()
+    {
+        if ( 0 == sleepers.load() ) return;
+#ifdef __linux__
+        futexWake(&generation);
+#else
+        { std::lock_guard<std::mutex> lock(mtx); }
+        cv.notify_all();
+#endif
+    }
+
+    void waitCentral()
+    {
+        uint32_t gen = generation.load();
+        size_t c = --count;
+        if ( 0 == c ) {
+            /* We should release */
+            count = origCount;
+            ++generation; /* Incrementing generation causes release */
+            wakeAll();
+        } else {
+            /* Try spinning first */
+            unsigned int spins = 0;
+            while ( gen == generation.load(std::memory_order_acquire) ) {
+                if ( ++spins > SPIN_COUNT ) {
+                    sleep(gen);
+                    break;
+                }
+                _mm_pause();
+            }
+        }
+    }
+
+    static inline bool reached(const Flag& flag, uint32_t epoch)
+    {
+        return (int32_t)(flag.epoch.load(std::memory_order_acquire) - epoch) >= 0;
+    }
+
+    void waitDissemination()
+    {
+        uint32_t me = threadIndex();
+        uint32_t epoch = ++epochs[me].count;
+        for ( unsigned int k = 0; k < rounds; k++ ) {
+            // Signal the thread 2^k ahead, then wait for the one 2^k
+            // behind.  After the last round every thread has heard
+            // (indirectly) from every other.
+            Flag& out = flags[((me + (1u << k)) % origCount) * rounds + k];
+            out.epoch.store(epoch);
+            if ( out.sleeping.load() ) futexWake(&out.epoch);
+
+            Flag& in = flags[me * rounds + k];
+            unsigned int spins = 0;
+            while ( !reached(in, epoch) && enabled ) {
+                if ( ++spins > SPIN_COUNT ) {
+                    in.sleeping.store(1);
+                    uint32_t value;
+                    while ( (int32_t)((value = in.epoch.load()) - epoch) < 0 && enabled ) {
+                        futexWait(&in.epoch, value);
+                    }
+                    in.sleeping.store(0);
+                    break;
+                }
+                _mm_pause();
+            }
+        }
+    }
+
+    void freeFlags()
+    {
+        if ( flags != NULL ) {
+            for ( size_t i = 0; i < origCount * rounds; i++ ) flags[i].~Flag();
+            free(flags);
+        }
+        if ( epochs != NULL ) {
+            for ( size_t i = 0; i < origCount; i++ ) epochs[i].~Epoch();
+            free(epochs);
+        }
+        flags = NULL;
+        epochs = NULL;
+    }
+
 public:
-    Barrier(size_t count) : origCount(count), enabled(true),
-            count(count), generation(0)
-    { }
+    Barrier(size_t count) : origCount(0), enabled(false),
+            count(0), generation(0), sleepers(0),
+            type(CENTRAL), rounds(0), flags(NULL), epochs(NULL)
+    {
+        resize(count);
+    }
 
     // Come g++ 4.7, this can become a delegating constructor
-    Barrier() : origCount(0), enabled(false), count(0), generation(0)
+    Barrier() : origCount(0), enabled(false), count(0), generation(0), sleepers(0),
+            type(CENTRAL), rounds(0), flags(NULL), epochs(NULL)
     { }
 
+    ~Barrier()
+    {
+        freeFlags();
+    }
+
+
+    /** Set the algorithm used by Barriers resized after this call */
+    static void setDefaultType(Type_t type) { defaultType() = type; }
+
+    /** Set the index (0 to count-1) of the calling thread.  Needed by
+     * the dissemination barrier, must be called before the thread
+     * first waits. */
+    static void setThreadIndex(uint32_t index) { threadIndex() = index; }
+
 
     /** ONLY call this while nobody is in wait() */
     void resize(size_t newCount)
     {
+        // Uses the old count and rounds
+        freeFlags();
+
         count = origCount = newCount;
         generation.store(0);
+
+        type = defaultType();
+        if ( type == DISSEMINATION ) {
+            rounds = 0;
+            while ( (size_t(1) << rounds) < newCount ) rounds++;
+            // Each Flag and Epoch must start on its own cache line
+            flags = static_cast<Flag*>(allocCacheAligned(newCount * rounds * sizeof(Flag)));
+            for ( size_t i = 0; i < newCount * rounds; i++ ) new (&flags[i]) Flag();
+            epochs = static_cast<Epoch*>(allocCacheAligned(newCount * sizeof(Epoch)));
+            for ( size_t i = 0; i < newCount; i++ ) new (&epochs[i]) Epoch();
+        }
         enabled.store(true);
     }
 
 
     /**
-     * Wait for all threads to reach this point.
-     * @return 0.0, or elapsed time spent waiting, if configured with --enable-profile
+     * Wait for all threads to reach this point.  Waiting threads spin
+     * for a while and then sleep until they are released.
+     * @return elapsed time spent waiting, in seconds
      */
     double wait()
     {
         double elapsed = 0.0;
         if ( enabled ) {
-            auto startTime = SST::Core::Profile::now();
-
-            size_t gen = generation.load();
-            size_t c = --count;
-            if ( 0 == c ) {
-                /* We should release */
-                count = origCount;
-                ++generation; /* Incrementing generation causes release */
-            } else {
-                /* Try spinning first */
-                do {
-                    _mm_pause();
-                } while ( gen == generation.load(std::memory_order_acquire) );
-            }
-            elapsed = SST::Core::Profile::getElapsed(startTime);
+            auto startTime = std::chrono::steady_clock::now();
+
+            if ( type == DISSEMINATION ) waitDissemination();
+            else waitCentral();
+
+            auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime).count();
+            BarrierWaitStats& stats = getThreadWaitStats();
+            stats.count.store(stats.count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            stats.nanoseconds.store(stats.nanoseconds.load(std::memory_order_relaxed) + ns, std::memory_order_relaxed);
+            elapsed = ns * 1e-9;
         }
         return elapsed;
     }
@@ -97,6 +322,18 @@ public:
         enabled.store(false);
         count.store(0);
         ++generation;
+        wakeAll();
+        if ( flags != NULL ) {
+            for ( size_t i = 0; i < origCount * rounds; i++ ) futexWake(&flags[i].epoch);
+        }
+    }
+
+    /** Return the wait statistics of the calling thread, summed over
+     * all Barriers */
+    static BarrierWaitStats& getThreadWaitStats()
+    {
+        static thread_local BarrierWaitStats stats;
+        return stats;
     }
 };
 
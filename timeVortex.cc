@@ -14,79 +14,78 @@
 #include "sst/core/serialization.h"
 
 #include <sst/core/timeVortex.h>
-#include <sst/core/output.h>
-
-#include <sst/core/clock.h>
-#include <sst/core/simulation.h>
 
 namespace SST {
 
 TimeVortex::TimeVortex() :
     ActivityQueue(),
     insertOrder(0),
+    insert_count(0),
     current_depth(0),
     max_depth(0)
 {}
 
-TimeVortex::~TimeVortex()
+unsigned int
+TimeVortex::popBatch(Activity** batch, unsigned int max_count)
 {
-    // Activities in TimeVortex all need to be deleted
-    while ( !data.empty() ) {
-        Activity *it = data.top();
-        delete it;
-        data.pop();
+    if ( max_count == 0 || empty() ) return 0;
+    batch[0] = pop();
+    unsigned int count = 1;
+    while ( count < max_count && !empty() ) {
+        Activity* next = front();
+        if ( next->getDeliveryTime() != batch[0]->getDeliveryTime() ||
+             next->getPriority() != batch[0]->getPriority() ) break;
+        batch[count++] = pop();
     }
+    return count;
 }
 
-bool TimeVortex::empty()
+void
+TimeVortex::extract(const std::function<bool(Activity*)>& select, std::vector<Activity*>& removed)
 {
-    return data.empty();
+    // Queue orders are kept, so putting the rest back restores the
+    // original order
+    std::vector<Activity*> kept;
+    while ( !empty() ) {
+        Activity* activity = pop();
+        if ( select(activity) ) removed.push_back(activity);
+        else kept.push_back(activity);
+    }
+    for ( size_t i = 0; i < kept.size(); i++ ) {
+        push(kept[i]);
+    }
 }
 
-int TimeVortex::size()
+bool
+TimeVortex::addTimeVortex(const std::string name, const TimeVortex::timeVortexAlloc alloc, const std::string description)
 {
-    return data.size();
+    timevortex_allocs()[name] = alloc;
+    timevortex_descriptions()[name] = description;
+    return true;
 }
 
-void TimeVortex::insert(Activity* activity)
+TimeVortex*
+TimeVortex::getTimeVortex(const std::string name)
 {
-    activity->setQueueOrder(insertOrder++);
-    data.push(activity);
-    current_depth++;
-    if ( current_depth > max_depth ) {
-        max_depth = current_depth;
-    }
+    std::map<std::string, timeVortexAlloc>::iterator it = timevortex_allocs().find(name);
+    if ( it == timevortex_allocs().end() ) return NULL;
+    return (*(it->second))();
 }
 
-Activity* TimeVortex::pop()
+std::map<std::string, TimeVortex::timeVortexAlloc>&
+TimeVortex::timevortex_allocs()
 {
-    if ( data.empty() ) return NULL;
-    Activity* ret_val = data.top();
-    data.pop();
-    current_depth--;
-    return ret_val;
-
+    static std::map<std::string, TimeVortex::timeVortexAlloc> cache;
+    return cache;
 }
 
-Activity* TimeVortex::front()
+std::map<std::string, std::string>&
+TimeVortex::timevortex_descriptions()
 {
-    return data.top();
+    static std::map<std::string, std::string> cache;
+    return cache;
 }
 
-void TimeVortex::print(Output &out) const
-{
-    out.output("TimeVortex state:\n");
-
-//  STL's priority_queue does not support iteration.
-//
-//    dataType_t::iterator it;
-//    for ( it = data.begin(); it != data.end(); it++ ) {
-//        (*it)->print("  ", out);
-//    }
-}
-
-
-
 } // namespace SST
 
 BOOST_CLASS_EXPORT_IMPLEMENT(SST::ActivityQueue)
@@ -14,9 +14,9 @@
 
 #include <sst/core/serialization.h>
 
-#include <cstdio> // For printf
 #include <functional>
-#include <queue>
+#include <map>
+#include <string>
 #include <vector>
 
 #include <sst/core/activityQueue.h>
@@ -27,32 +27,120 @@ class Output;
 
 /**
  * Primary Event Queue
+ *
+ * Base class for the primary event queue.  All implementations must
+ * return Activities in exactly the order defined by
+ * Activity::pq_less_time_priority (delivery time, then priority, then
+ * insertion order), so that the choice of implementation never changes
+ * simulation results.  Implementations register themselves by name
+ * and are selected at startup with the --time-vortex option.
  */
 class TimeVortex : public ActivityQueue {
 public:
+    typedef TimeVortex* (*timeVortexAlloc)();
+
 	TimeVortex();
-    ~TimeVortex();
+    virtual ~TimeVortex() {}
+
+    virtual bool empty() = 0;
+    virtual int size() = 0;
+    /** Insert an Activity, assigning it the next queue order */
+    void insert(Activity* activity) {
+        activity->setQueueOrder(insertOrder++);
+        insert_count++;
+        push(activity);
+    }
+    /** Insert Activities in array order, each getting the next queue
+     * order */
+    void insertBatch(Activity** activities, size_t count) {
+        for ( size_t i = 0; i < count; i++ ) {
+            activities[i]->setQueueOrder(insertOrder++);
+            push(activities[i]);
+        }
+        insert_count += count;
+    }
+    /** Insert an Activity whose queue order was reserved earlier with
+     * reserveQueueOrder().  Used to delay inserting an Activity
+     * without changing where it sorts relative to other Activities
+     * with the same time and priority. */
+    void insertOrdered(Activity* activity) {
+        insert_count++;
+        push(activity);
+    }
+    /** Reserve a queue order for an Activity that will be inserted
+     * later with insertOrdered() */
+    uint64_t reserveQueueOrder() { return insertOrder++; }
+    /** Reserve count consecutive queue orders.
+     * @return The first of the reserved orders */
+    uint64_t reserveQueueOrders(size_t count) {
+        uint64_t first = insertOrder;
+        insertOrder += count;
+        return first;
+    }
+    virtual Activity* pop() = 0;
+    virtual Activity* front() = 0;
 
-    bool empty();
-    int size();
-    void insert(Activity* activity);
-    Activity* pop();
-    Activity* front();
+    /** Remove up to max_count Activities that share the delivery time
+     * and priority of the Activity at the front of the queue.  The
+     * Activities are written to batch in delivery order.
+     * @return Number of Activities removed (zero if the queue is empty)
+     */
+    virtual unsigned int popBatch(Activity** batch, unsigned int max_count);
+
+    /** Remove every Activity for which select returns true and append
+     * them to removed in delivery order.  The other Activities keep
+     * their places.  Walks the whole queue, so it is only meant for
+     * rare reorganizations such as moving a Component to another
+     * thread. */
+    void extract(const std::function<bool(Activity*)>& select, std::vector<Activity*>& removed);
 
     /** Print the state of the TimeVortex */
-    void print(Output &out) const;
+    virtual void print(Output &out) const = 0;
 
+    /** Number of Activities waiting to be delivered, including those
+     * counted with addHeld() */
     uint64_t getCurrentDepth() const { return current_depth; }
     uint64_t getMaxDepth() const { return max_depth; }
-    
-private:
-    typedef std::priority_queue<Activity*, std::vector<Activity*>, Activity::pq_less_time_priority> dataType_t;
-    dataType_t data;
+    /** Count Activities that are ordered against this TimeVortex but
+     * held outside of it (e.g. by a LinkDelayLine or the ClockRing) in
+     * the depth, so it matches putting everything in one queue */
+    void addHeld(uint64_t count = 1) {
+        current_depth += count;
+        if ( current_depth > max_depth ) max_depth = current_depth;
+    }
+    /** Stop counting Activities added with addHeld() */
+    void removeHeld(uint64_t count = 1) { current_depth -= count; }
+    /** Returns the number of Activities inserted so far.  Can be used
+     * to cheaply detect that the queue has been added to. */
+    uint64_t getInsertCount() const { return insert_count; }
+
+    /** Register a TimeVortex implementation
+     * @param name - name used to select the implementation
+     * @param alloc - function used to create an instance
+     * @param description - description printed in the help text
+     */
+    static bool addTimeVortex(const std::string name, const timeVortexAlloc alloc, const std::string description);
+    /** Create a TimeVortex of the named type.  Returns NULL if no
+     * implementation has been registered with that name. */
+    static TimeVortex* getTimeVortex(const std::string name);
+
+    static const std::map<std::string, std::string>& getDescriptionMap() { return timevortex_descriptions(); }
+
+protected:
+    /** Add an Activity to the queue.  The queue order has already
+     * been set. */
+    virtual void push(Activity* activity) = 0;
+
     uint64_t insertOrder;
+    uint64_t insert_count;
 
     uint64_t current_depth;
     uint64_t max_depth;
-    
+
+private:
+    static std::map<std::string, timeVortexAlloc>& timevortex_allocs();
+    static std::map<std::string, std::string>& timevortex_descriptions();
+
     friend class boost::serialization::access;
     template<class Archive>
     void
@@ -60,8 +148,6 @@ private:
     {
         printf("begin TimeVortex::serialize\n");
         ar & BOOST_SERIALIZATION_BASE_OBJECT_NVP(ActivityQueue);
-        printf("  - TimeVortex::data\n");
-//        ar & BOOST_SERIALIZATION_NVP(data);
         printf("end TimeVortex::serialize\n");
     }
 };
@@ -0,0 +1,249 @@
+// Copyright 2009-2015 Sandia Corporation. Under the terms
+// of Contract DE-AC04-94AL85000 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+// 
+// Copyright (c) 2009-2015, Sandia Corporation
+// All rights reserved.
+// 
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include "sst_config.h"
+#include "sst/core/serialization.h"
+
+#include <sst/core/timevortex/timeVortexCalendar.h>
+#include <sst/core/output.h>
+
+#include <algorithm>
+
+namespace SST {
+namespace TV {
+
+bool TimeVortexCalendar::initialized = TimeVortex::addTimeVortex("calendar", &TimeVortexCalendar::allocate, "Calendar queue.  Amortized O(1) insert and pop when the spread of pending delivery times is stable.");
+
+// Smallest number of buckets the calendar will shrink to
+static const size_t MIN_BUCKETS = 16;
+// Number of earliest Activities sampled to estimate the slot width
+static const size_t WIDTH_SAMPLE = 64;
+
+TimeVortexCalendar::TimeVortexCalendar() :
+    TimeVortex(),
+    buckets(MIN_BUCKETS),
+    bucket_mask(MIN_BUCKETS - 1),
+    width_shift(0),
+    count(0),
+    current_slot(0),
+    head(NULL),
+    head_bucket(0)
+{}
+
+TimeVortexCalendar::~TimeVortexCalendar()
+{
+    // Activities in TimeVortex all need to be deleted
+    for ( size_t i = 0; i < buckets.size(); i++ ) {
+        for ( size_t j = buckets[i].first; j < buckets[i].items.size(); j++ ) {
+            delete buckets[i].items[j];
+        }
+    }
+}
+
+bool TimeVortexCalendar::empty()
+{
+    return count == 0;
+}
+
+int TimeVortexCalendar::size()
+{
+    return count;
+}
+
+void TimeVortexCalendar::bucketInsert(Activity* activity)
+{
+    bucket_t& bucket = buckets[slotOf(activity) & bucket_mask];
+    std::vector<Activity*>& items = bucket.items;
+    if ( bucket.empty() || !later(items.back(), activity) ) {
+        items.push_back(activity);
+    }
+    else if ( bucket.first > 0 && later(items[bucket.first], activity) ) {
+        // Earlier than everything left (i.e. from a sync object), so
+        // reuse the space in front
+        items[--bucket.first] = activity;
+    }
+    else {
+        items.insert(std::upper_bound(items.begin() + bucket.first, items.end(), activity,
+                                      [this](Activity* lhs, Activity* rhs) { return later(rhs, lhs); }),
+                     activity);
+    }
+}
+
+void TimeVortexCalendar::push(Activity* activity)
+{
+    bucketInsert(activity);
+    count++;
+    current_depth++;
+    if ( current_depth > max_depth ) {
+        max_depth = current_depth;
+    }
+
+    // Activities may be inserted earlier than the current head
+    // (i.e. by the sync objects), so back up the scan if needed
+    uint64_t slot = slotOf(activity);
+    if ( slot < current_slot ) current_slot = slot;
+    if ( head != NULL && later(head, activity) ) {
+        head = activity;
+        head_bucket = slot & bucket_mask;
+    }
+
+    if ( count > 2 * buckets.size() ) resize(2 * buckets.size());
+}
+
+void TimeVortexCalendar::findHead()
+{
+    head = NULL;
+    if ( count == 0 ) return;
+
+    // Walk the calendar one slot at a time starting at the current
+    // slot.  The first bucket whose earliest entry falls in the slot
+    // being examined holds the earliest Activity overall.
+    uint64_t slot = current_slot;
+    for ( size_t i = 0; i < buckets.size(); i++, slot++ ) {
+        bucket_t& bucket = buckets[slot & bucket_mask];
+        if ( !bucket.empty() && slotOf(bucket.front()) <= slot ) {
+            head = bucket.front();
+            head_bucket = slot & bucket_mask;
+            current_slot = slot;
+            return;
+        }
+    }
+
+    // Nothing within a full trip around the calendar, so fall back to
+    // a direct search of the bucket minimums.
+    for ( size_t i = 0; i < buckets.size(); i++ ) {
+        if ( buckets[i].empty() ) continue;
+        if ( head == NULL || later(head, buckets[i].front()) ) {
+            head = buckets[i].front();
+            head_bucket = i;
+        }
+    }
+    current_slot = slotOf(head);
+}
+
+Activity* TimeVortexCalendar::pop()
+{
+    if ( head == NULL ) findHead();
+    if ( head == NULL ) return NULL;
+
+    Activity* ret_val = head;
+    buckets[head_bucket].consume(1);
+    head = NULL;
+    count--;
+    current_depth--;
+
+    if ( buckets.size() > MIN_BUCKETS && count < buckets.size() / 2 ) resize(buckets.size() / 2);
+    return ret_val;
+}
+
+unsigned int TimeVortexCalendar::popBatch(Activity** batch, unsigned int max_count)
+{
+    if ( head == NULL ) findHead();
+    if ( head == NULL || max_count == 0 ) return 0;
+
+    // Activities with the same time and priority always share a
+    // bucket and sit next to each other at its head
+    bucket_t& bucket = buckets[head_bucket];
+    SimTime_t time = head->getDeliveryTime();
+    int priority = head->getPriority();
+    unsigned int n = 0;
+    for ( size_t i = bucket.first; i < bucket.items.size() && n < max_count; i++ ) {
+        Activity* activity = bucket.items[i];
+        if ( activity->getDeliveryTime() != time || activity->getPriority() != priority ) break;
+        batch[n++] = activity;
+    }
+    bucket.consume(n);
+    head = NULL;
+    count -= n;
+    current_depth -= n;
+
+    if ( buckets.size() > MIN_BUCKETS && count < buckets.size() / 2 ) resize(buckets.size() / 2);
+    return n;
+}
+
+Activity* TimeVortexCalendar::front()
+{
+    if ( head == NULL ) findHead();
+    return head;
+}
+
+void TimeVortexCalendar::resize(size_t new_nbuckets)
+{
+    std::vector<Activity*> all;
+    all.reserve(count);
+    for ( size_t i = 0; i < buckets.size(); i++ ) {
+        all.insert(all.end(), buckets[i].items.begin() + buckets[i].first, buckets[i].items.end());
+    }
+
+    // In delivery order, so that every bucketInsert() below is an
+    // append
+    std::sort(all.begin(), all.end(), [this](Activity* lhs, Activity* rhs) { return later(rhs, lhs); });
+
+    // Estimate the slot width as three times the average separation
+    // of the earliest delivery times, ignoring separations more than
+    // twice the average (R. Brown's heuristic).
+    size_t nsample = std::min(all.size(), WIDTH_SAMPLE);
+    if ( nsample > 1 ) {
+
+        SimTime_t total = 0;
+        size_t ngaps = 0;
+        for ( size_t i = 1; i < nsample; i++ ) {
+            SimTime_t gap = all[i]->getDeliveryTime() - all[i-1]->getDeliveryTime();
+            if ( gap == 0 ) continue;
+            total += gap;
+            ngaps++;
+        }
+        if ( ngaps > 0 ) {
+            SimTime_t average = total / ngaps;
+            SimTime_t trimmed_total = 0;
+            size_t trimmed_gaps = 0;
+            for ( size_t i = 1; i < nsample; i++ ) {
+                SimTime_t gap = all[i]->getDeliveryTime() - all[i-1]->getDeliveryTime();
+                if ( gap == 0 || gap > 2 * average ) continue;
+                trimmed_total += gap;
+                trimmed_gaps++;
+            }
+            if ( trimmed_gaps > 0 ) average = trimmed_total / trimmed_gaps;
+
+            SimTime_t width = 3 * average;
+            width_shift = 0;
+            while ( width_shift < 63 && (SimTime_t(1) << width_shift) < width ) width_shift++;
+        }
+    }
+
+    buckets.clear();
+    buckets.resize(new_nbuckets);
+    bucket_mask = new_nbuckets - 1;
+    head = NULL;
+    current_slot = MAX_SIMTIME_T;
+    for ( size_t i = 0; i < all.size(); i++ ) {
+        bucketInsert(all[i]);
+    }
+    current_slot = all.empty() ? 0 : slotOf(all[0]);
+}
+
+void TimeVortexCalendar::print(Output &out) const
+{
+    out.output("TimeVortex state:\n");
+    out.output("  calendar: %zu entries in %zu buckets, slot width %" PRIu64 "\n",
+               count, buckets.size(), SimTime_t(1) << width_shift);
+    for ( size_t i = 0; i < buckets.size(); i++ ) {
+        for ( size_t j = buckets[i].first; j < buckets[i].items.size(); j++ ) {
+            buckets[i].items[j]->print("  ", out);
+        }
+    }
+}
+
+} // namespace TV
+} // namespace SST
+
+BOOST_CLASS_EXPORT_IMPLEMENT(SST::TV::TimeVortexCalendar)
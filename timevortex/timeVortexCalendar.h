@@ -0,0 +1,132 @@
+// Copyright 2009-2015 Sandia Corporation. Under the terms
+// of Contract DE-AC04-94AL85000 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+// 
+// Copyright (c) 2009-2015, Sandia Corporation
+// All rights reserved.
+// 
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef SST_CORE_TIMEVORTEX_TIMEVORTEXCALENDAR_H
+#define SST_CORE_TIMEVORTEX_TIMEVORTEXCALENDAR_H
+
+#include <sst/core/serialization.h>
+
+#include <cstdio> // For printf
+#include <vector>
+
+#include <sst/core/timeVortex.h>
+
+namespace SST {
+
+class Output;
+
+namespace TV {
+
+/**
+ * Primary Event Queue implemented as a calendar queue (R. Brown,
+ * CACM 1988).
+ *
+ * Time is divided into slots of a fixed width (a power of two number
+ * of core cycles) and slots are mapped round-robin onto a power of
+ * two number of buckets.  Each bucket holds its Activities in
+ * delivery order, with the earliest at a head index that advances as
+ * they are popped.  A new Activity usually sorts after everything in
+ * its bucket (e.g. a clock's events, which share a time), so insert
+ * is normally an append.  For event populations with a stable spread
+ * of delivery times, insert and pop are amortized O(1).  The bucket count and
+ * slot width are re-tuned whenever the population grows or shrinks
+ * by a factor of two.
+ */
+class TimeVortexCalendar : public TimeVortex {
+public:
+	TimeVortexCalendar();
+    ~TimeVortexCalendar();
+
+    bool empty();
+    int size();
+    Activity* pop();
+    Activity* front();
+    unsigned int popBatch(Activity** batch, unsigned int max_count);
+
+    /** Print the state of the TimeVortex */
+    void print(Output &out) const;
+
+    static TimeVortex* allocate() { return new TimeVortexCalendar(); }
+    
+protected:
+    void push(Activity* activity);
+
+private:
+    static bool initialized;
+
+    struct bucket_t {
+        std::vector<Activity*> items;
+        /** Index of the earliest Activity */
+        size_t first;
+
+        bucket_t() : first(0) {}
+
+        inline bool empty() const { return first == items.size(); }
+        inline Activity* front() const { return items[first]; }
+
+        /** Remove the n earliest Activities */
+        inline void consume(size_t n) {
+            first += n;
+            if ( first == items.size() ) {
+                items.clear();
+                first = 0;
+            }
+            else if ( first >= 64 && 2 * first >= items.size() ) {
+                // Reclaim the front once it is most of the vector
+                items.erase(items.begin(), items.begin() + first);
+                first = 0;
+            }
+        }
+    };
+
+    /** Find the earliest Activity and cache it in head/head_bucket */
+    void findHead();
+    /** Insert into the bucket array without any bookkeeping */
+    void bucketInsert(Activity* activity);
+    /** Rebuild the calendar with the given number of buckets,
+     * re-estimating the slot width from the current contents */
+    void resize(size_t new_nbuckets);
+
+    inline uint64_t slotOf(const Activity* activity) const {
+        return activity->getDeliveryTime() >> width_shift;
+    }
+
+    std::vector<bucket_t> buckets;
+    uint64_t bucket_mask;
+    uint32_t width_shift;
+    size_t count;
+
+    /** Slot currently being scanned for the next Activity */
+    uint64_t current_slot;
+
+    /** Cached earliest Activity (NULL if it needs to be found) */
+    Activity* head;
+    size_t head_bucket;
+
+    Activity::pq_less_time_priority later;
+
+    friend class boost::serialization::access;
+    template<class Archive>
+    void
+    serialize(Archive & ar, const unsigned int version )
+    {
+        printf("begin TimeVortexCalendar::serialize\n");
+        ar & BOOST_SERIALIZATION_BASE_OBJECT_NVP(TimeVortex);
+        printf("end TimeVortexCalendar::serialize\n");
+    }
+};
+
+} //namespace TV
+} //namespace SST
+
+BOOST_CLASS_EXPORT_KEY(SST::TV::TimeVortexCalendar)
+
+#endif // SST_CORE_TIMEVORTEX_TIMEVORTEXCALENDAR_H
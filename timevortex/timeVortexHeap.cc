@@ -0,0 +1,165 @@
+// Copyright 2009-2015 Sandia Corporation. Under the terms
+// of Contract DE-AC04-94AL85000 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+// 
+// Copyright (c) 2009-2015, Sandia Corporation
+// All rights reserved.
+// 
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include "sst_config.h"
+#include "sst/core/serialization.h"
+
+#include <sst/core/timevortex/timeVortexHeap.h>
+#include <sst/core/output.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+namespace SST {
+namespace TV {
+
+bool TimeVortexHeap::initialized = TimeVortex::addTimeVortex("heap4", &TimeVortexHeap::allocate, "Cache-aligned 4-ary heap with the sort keys stored in the heap nodes.");
+
+// Alignment of the node array; one group of four siblings
+static const size_t HEAP_ALIGN = 128;
+
+TimeVortexHeap::TimeVortexHeap() :
+    TimeVortex(),
+    data(NULL),
+    count(0),
+    capacity(0)
+{
+    grow();
+}
+
+TimeVortexHeap::~TimeVortexHeap()
+{
+    // Activities in TimeVortex all need to be deleted
+    for ( size_t i = ROOT; i < ROOT + count; i++ ) {
+        delete data[i].activity;
+    }
+    free(data);
+}
+
+void TimeVortexHeap::grow()
+{
+    size_t new_capacity = capacity == 0 ? 1024 : 2 * capacity;
+    void* ptr = NULL;
+    int ret = posix_memalign(&ptr, HEAP_ALIGN, new_capacity * sizeof(node_t));
+    if ( ret != 0 ) {
+        fprintf(stderr, "TimeVortexHeap failed to allocate %zu entries.  Error: %s\n", new_capacity, strerror(ret));
+        abort();
+    }
+    node_t* new_data = static_cast<node_t*>(ptr);
+    if ( data != NULL ) {
+        memcpy(new_data, data, (ROOT + count) * sizeof(node_t));
+        free(data);
+    }
+    data = new_data;
+    capacity = new_capacity;
+}
+
+bool TimeVortexHeap::empty()
+{
+    return count == 0;
+}
+
+int TimeVortexHeap::size()
+{
+    return count;
+}
+
+void TimeVortexHeap::push(Activity* activity)
+{
+    if ( ROOT + count == capacity ) grow();
+
+    node_t node;
+    node.time = activity->getDeliveryTime();
+    node.priority = activity->getPriority();
+    node.pad = 0;
+    node.order = activity->getQueueOrder();
+    node.activity = activity;
+
+    // Sift the hole up from the end of the array
+    size_t hole = ROOT + count;
+    while ( hole > ROOT ) {
+        size_t p = parent(hole);
+        if ( !node.before(data[p]) ) break;
+        data[hole] = data[p];
+        hole = p;
+    }
+    data[hole] = node;
+
+    count++;
+    current_depth++;
+    if ( current_depth > max_depth ) {
+        max_depth = current_depth;
+    }
+}
+
+Activity* TimeVortexHeap::pop()
+{
+    if ( count == 0 ) return NULL;
+    Activity* ret_val = data[ROOT].activity;
+    count--;
+    current_depth--;
+    if ( count == 0 ) return ret_val;
+
+    // Sift the last node down from the root
+    const node_t node = data[ROOT + count];
+    const size_t end = ROOT + count;
+    size_t hole = ROOT;
+    while ( true ) {
+        size_t child = firstChild(hole);
+        if ( child >= end ) break;
+        size_t last = child + 4 < end ? child + 4 : end;
+        size_t best = child;
+        for ( size_t c = child + 1; c < last; c++ ) {
+            if ( data[c].before(data[best]) ) best = c;
+        }
+        if ( !data[best].before(node) ) break;
+        data[hole] = data[best];
+        hole = best;
+    }
+    data[hole] = node;
+    return ret_val;
+}
+
+unsigned int TimeVortexHeap::popBatch(Activity** batch, unsigned int max_count)
+{
+    if ( count == 0 || max_count == 0 ) return 0;
+
+    // Compare against the key stored in the root node so the
+    // remaining Activities are never touched
+    SimTime_t time = data[ROOT].time;
+    int priority = data[ROOT].priority;
+    unsigned int n = 0;
+    while ( n < max_count && count > 0 && data[ROOT].time == time && data[ROOT].priority == priority ) {
+        batch[n++] = pop();
+    }
+    return n;
+}
+
+Activity* TimeVortexHeap::front()
+{
+    if ( count == 0 ) return NULL;
+    return data[ROOT].activity;
+}
+
+void TimeVortexHeap::print(Output &out) const
+{
+    out.output("TimeVortex state:\n");
+    for ( size_t i = ROOT; i < ROOT + count; i++ ) {
+        data[i].activity->print("  ", out);
+    }
+}
+
+} // namespace TV
+} // namespace SST
+
+BOOST_CLASS_EXPORT_IMPLEMENT(SST::TV::TimeVortexHeap)
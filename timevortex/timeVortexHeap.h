@@ -0,0 +1,102 @@
+// Copyright 2009-2015 Sandia Corporation. Under the terms
+// of Contract DE-AC04-94AL85000 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+// 
+// Copyright (c) 2009-2015, Sandia Corporation
+// All rights reserved.
+// 
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef SST_CORE_TIMEVORTEX_TIMEVORTEXHEAP_H
+#define SST_CORE_TIMEVORTEX_TIMEVORTEXHEAP_H
+
+#include <sst/core/serialization.h>
+
+#include <cstdio> // For printf
+
+#include <sst/core/timeVortex.h>
+
+namespace SST {
+
+class Output;
+
+namespace TV {
+
+/**
+ * Primary Event Queue implemented as a 4-ary heap whose nodes carry a
+ * copy of the sort key (delivery time, priority, queue order) next to
+ * the Activity pointer, so sifting never dereferences an Activity.
+ *
+ * Nodes are 32 bytes and the array is laid out so that every group
+ * of four siblings starts on a 128 byte boundary: the root lives at
+ * index 3, the children of node p are 4p-8 .. 4p-5 and the parent of
+ * node c is c/4 + 2.  Examining all children of a node therefore
+ * touches one aligned pair of cache lines.
+ */
+class TimeVortexHeap : public TimeVortex {
+public:
+	TimeVortexHeap();
+    ~TimeVortexHeap();
+
+    bool empty();
+    int size();
+    Activity* pop();
+    Activity* front();
+    unsigned int popBatch(Activity** batch, unsigned int max_count);
+
+    /** Print the state of the TimeVortex */
+    void print(Output &out) const;
+
+    static TimeVortex* allocate() { return new TimeVortexHeap(); }
+    
+protected:
+    void push(Activity* activity);
+
+private:
+    static bool initialized;
+
+    struct node_t {
+        SimTime_t time;
+        int       priority;
+        uint32_t  pad;
+        uint64_t  order;
+        Activity* activity;
+
+        /** Returns true if this node should be delivered before rhs */
+        inline bool before(const node_t& rhs) const {
+            if ( time != rhs.time ) return time < rhs.time;
+            if ( priority != rhs.priority ) return priority < rhs.priority;
+            return order < rhs.order;
+        }
+    };
+
+    static const size_t ROOT = 3;
+
+    static inline size_t firstChild(size_t node) { return 4 * node - 8; }
+    static inline size_t parent(size_t node) { return node / 4 + 2; }
+
+    void grow();
+
+    node_t* data;
+    size_t count;
+    size_t capacity;
+
+    friend class boost::serialization::access;
+    template<class Archive>
+    void
+    serialize(Archive & ar, const unsigned int version )
+    {
+        printf("begin TimeVortexHeap::serialize\n");
+        ar & BOOST_SERIALIZATION_BASE_OBJECT_NVP(TimeVortex);
+        printf("end TimeVortexHeap::serialize\n");
+    }
+};
+
+} //namespace TV
+} //namespace SST
+
+BOOST_CLASS_EXPORT_KEY(SST::TV::TimeVortexHeap)
+
+#endif // SST_CORE_TIMEVORTEX_TIMEVORTEXHEAP_H
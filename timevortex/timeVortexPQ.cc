@@ -0,0 +1,87 @@
+// Copyright 2009-2015 Sandia Corporation. Under the terms
+// of Contract DE-AC04-94AL85000 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+// 
+// Copyright (c) 2009-2015, Sandia Corporation
+// All rights reserved.
+// 
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include "sst_config.h"
+#include "sst/core/serialization.h"
+
+#include <sst/core/timevortex/timeVortexPQ.h>
+#include <sst/core/output.h>
+
+namespace SST {
+namespace TV {
+
+bool TimeVortexPQ::initialized = TimeVortex::addTimeVortex("pq", &TimeVortexPQ::allocate, "Binary heap (std::priority_queue).  Default.");
+
+TimeVortexPQ::TimeVortexPQ() :
+    TimeVortex()
+{}
+
+TimeVortexPQ::~TimeVortexPQ()
+{
+    // Activities in TimeVortex all need to be deleted
+    while ( !data.empty() ) {
+        Activity *it = data.top();
+        delete it;
+        data.pop();
+    }
+}
+
+bool TimeVortexPQ::empty()
+{
+    return data.empty();
+}
+
+int TimeVortexPQ::size()
+{
+    return data.size();
+}
+
+void TimeVortexPQ::push(Activity* activity)
+{
+    data.push(activity);
+    current_depth++;
+    if ( current_depth > max_depth ) {
+        max_depth = current_depth;
+    }
+}
+
+Activity* TimeVortexPQ::pop()
+{
+    if ( data.empty() ) return NULL;
+    Activity* ret_val = data.top();
+    data.pop();
+    current_depth--;
+    return ret_val;
+
+}
+
+Activity* TimeVortexPQ::front()
+{
+    return data.top();
+}
+
+void TimeVortexPQ::print(Output &out) const
+{
+    out.output("TimeVortex state:\n");
+
+//  STL's priority_queue does not support iteration.
+//
+//    dataType_t::iterator it;
+//    for ( it = data.begin(); it != data.end(); it++ ) {
+//        (*it)->print("  ", out);
+//    }
+}
+
+} // namespace TV
+} // namespace SST
+
+BOOST_CLASS_EXPORT_IMPLEMENT(SST::TV::TimeVortexPQ)
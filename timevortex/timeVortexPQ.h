@@ -0,0 +1,76 @@
+// Copyright 2009-2015 Sandia Corporation. Under the terms
+// of Contract DE-AC04-94AL85000 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+// 
+// Copyright (c) 2009-2015, Sandia Corporation
+// All rights reserved.
+// 
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef SST_CORE_TIMEVORTEX_TIMEVORTEXPQ_H
+#define SST_CORE_TIMEVORTEX_TIMEVORTEXPQ_H
+
+#include <sst/core/serialization.h>
+
+#include <cstdio> // For printf
+#include <functional>
+#include <queue>
+#include <vector>
+
+#include <sst/core/timeVortex.h>
+
+namespace SST {
+
+class Output;
+
+namespace TV {
+
+/**
+ * Primary Event Queue implemented as a binary heap
+ * (std::priority_queue).  This is the default TimeVortex.
+ */
+class TimeVortexPQ : public TimeVortex {
+public:
+	TimeVortexPQ();
+    ~TimeVortexPQ();
+
+    bool empty();
+    int size();
+    Activity* pop();
+    Activity* front();
+
+    /** Print the state of the TimeVortex */
+    void print(Output &out) const;
+
+    static TimeVortex* allocate() { return new TimeVortexPQ(); }
+    
+protected:
+    void push(Activity* activity);
+
+private:
+    static bool initialized;
+
+    typedef std::priority_queue<Activity*, std::vector<Activity*>, Activity::pq_less_time_priority> dataType_t;
+    dataType_t data;
+
+    friend class boost::serialization::access;
+    template<class Archive>
+    void
+    serialize(Archive & ar, const unsigned int version )
+    {
+        printf("begin TimeVortexPQ::serialize\n");
+        ar & BOOST_SERIALIZATION_BASE_OBJECT_NVP(TimeVortex);
+        printf("  - TimeVortexPQ::data\n");
+//        ar & BOOST_SERIALIZATION_NVP(data);
+        printf("end TimeVortexPQ::serialize\n");
+    }
+};
+
+} //namespace TV
+} //namespace SST
+
+BOOST_CLASS_EXPORT_KEY(SST::TV::TimeVortexPQ)
+
+#endif // SST_CORE_TIMEVORTEX_TIMEVORTEXPQ_H